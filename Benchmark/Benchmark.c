@@ -0,0 +1,101 @@
+/* *****************************************************************************
+ * @Summary Host Benchmark
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Benchmark.c
+ * 
+ * @Description
+ *      Runs all of the benchmarks and prints the results. Operations are 
+ *      whatever makes sense for each test: one byte, one tick, and so on.
+ * 
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+#include "Benchmark.h"
+
+// ***** Defines ***************************************************************
+
+
+// ***** Function Prototypes ***************************************************
+
+
+// ***** Global Variables ******************************************************
+
+volatile uint32_t benchmarkSink;
+
+static uint16_t failedChecks;
+
+// *****************************************************************************
+
+int main(void)
+{
+    printf("%s\n", BENCHMARK_NAME);
+    printf("%-40s %14s %10s %10s\n", "test", "operations", "ns/op", "MB/s");
+    
+    BufferBenchmark_Run();
+    TimerBenchmark_Run();
+    ButtonBenchmark_Run();
+    COBSBenchmark_Run();
+    SchedulerBenchmark_Run();
+    PoolBenchmark_Run();
+    RecordBufferBenchmark_Run();
+    TraceBenchmark_Run();
+    DoubleBufferBenchmark_Run();
+    CRCBenchmark_Run();
+    
+    if(failedChecks != 0)
+    {
+        printf("%u checks failed\n", failedChecks);
+        return 1;
+    }
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t Benchmark_GetTimeNs(void)
+{
+    struct timespec now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+// -----------------------------------------------------------------------------
+
+void Benchmark_Report(const char *name, uint64_t operations, uint64_t bytes, uint64_t elapsedNs)
+{
+    double nsPerOp = operations ? (double)elapsedNs / (double)operations : 0.0;
+    
+    if(bytes != 0 && elapsedNs != 0)
+    {
+        double megabytesPerSecond = (double)bytes * 1000.0 / (double)elapsedNs;
+        printf("%-40s %14llu %10.2f %10.1f\n", name, (unsigned long long)operations, nsPerOp, megabytesPerSecond);
+    }
+    else
+    {
+        printf("%-40s %14llu %10.2f %10s\n", name, (unsigned long long)operations, nsPerOp, "-");
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void Benchmark_Check(const char *name, bool passed)
+{
+    // Only the ones that fail get printed, so the table stays readable
+    if(!passed)
+    {
+        printf("FAILED: %s\n", name);
+        failedChecks++;
+    }
+}
+
+/*
+ End of File
+ */
@@ -0,0 +1,68 @@
+/* *****************************************************************************
+ * @Summary Host Benchmark Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Benchmark.h
+ * 
+ * @Description
+ *      A few helpers for timing the libraries on a PC. Each benchmark runs a 
+ *      loop a bunch of times, measures how long it took, and prints the time
+ *      per operation. The numbers won't match a PIC, but they are good for 
+ *      comparing one option against another and for catching things that 
+ *      suddenly got slower.
+ * 
+ *      Each benchmark also checks that the work it timed came out right. A 
+ *      check that fails is printed, and the program returns an error so 
+ *      that "make run" stops.
+ * 
+*******************************************************************************/
+
+#ifndef BENCHMARK_H
+#define	BENCHMARK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+#ifndef BENCHMARK_NAME
+#define BENCHMARK_NAME  "benchmark"
+#endif
+
+// ***** Global Variables ******************************************************
+
+/*  Results get added to this so the compiler can't throw the work away */
+extern volatile uint32_t benchmarkSink;
+
+// ***** Function Prototypes ***************************************************
+
+uint64_t Benchmark_GetTimeNs(void);
+
+void Benchmark_Report(const char *name, uint64_t operations, uint64_t bytes, uint64_t elapsedNs);
+
+void Benchmark_Check(const char *name, bool passed);
+
+void BufferBenchmark_Run(void);
+
+void TimerBenchmark_Run(void);
+
+void ButtonBenchmark_Run(void);
+
+void COBSBenchmark_Run(void);
+
+void SchedulerBenchmark_Run(void);
+
+void PoolBenchmark_Run(void);
+
+void RecordBufferBenchmark_Run(void);
+
+void TraceBenchmark_Run(void);
+
+void DoubleBufferBenchmark_Run(void);
+
+void CRCBenchmark_Run(void);
+
+#endif	/* BENCHMARK_H */
@@ -0,0 +1,524 @@
+/* *****************************************************************************
+ * @Summary Buffer Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File BufferBenchmark.c
+ * 
+ * @Description
+ *      Pushes bytes through a Buffer one at a time, in blocks, and in place. 
+ *      Also pushes records through a Queue. The buffer is filled half way and 
+ *      drained each time around so that the indexes keep wrapping. Lines are
+ *      pulled out of a Buffer byte by byte and with Buffer_FrameAvailable.
+ *      
+ *      Before any of that, a counting pattern is pushed through with every 
+ *      kind of read and write in uneven pieces, so that whatever options the
+ *      variant was built with, the data has to come out in the same order 
+ *      it went in.
+ * 
+*******************************************************************************/
+
+#include <string.h>
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "Queue.h"
+
+// ***** Defines ***************************************************************
+
+#define TOTAL_BYTES     (64u * 1024u * 1024u)
+
+#if BUFFER_INDEX_SIZE > 8
+#define BUFFER_SIZE     1024
+#else
+#define BUFFER_SIZE     128
+#endif
+
+#define BLOCK_SIZE      (BUFFER_SIZE / 2)
+
+// ***** Function Prototypes ***************************************************
+
+static void CheckWrapping(void);
+static void CheckFindByte(void);
+static void CheckWatermarks(void);
+static void CountHigh(Buffer *bufferContext);
+static void CountLow(Buffer *bufferContext);
+static void CheckQueue(void);
+static void WriteReadChar(void);
+static void WriteReadBlock(void);
+static void ContiguousSpans(void);
+static void FrameScan(void);
+static void QueueRecords(void);
+
+// ***** Global Variables ******************************************************
+
+static uint8_t array[BUFFER_SIZE];
+static uint8_t block[BLOCK_SIZE];
+static Buffer buffer;
+static uint8_t highCount;
+static uint8_t lowCount;
+
+// *****************************************************************************
+
+void BufferBenchmark_Run(void)
+{
+    CheckWrapping();
+    CheckFindByte();
+    CheckWatermarks();
+    CheckQueue();
+    WriteReadChar();
+    WriteReadBlock();
+    ContiguousSpans();
+    FrameScan();
+    QueueRecords();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckWrapping(void)
+{
+    uint8_t piece[37];
+    uint8_t nextIn = 0;
+    uint8_t nextOut = 0;
+    uint32_t bad = 0;
+    uint32_t moved = 0;
+    uint32_t round;
+    BufferIndex length, i;
+    uint8_t *data;
+    
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    
+    // The piece sizes don't divide the buffer, so every kind of read and 
+    // write ends up split across the end sooner or later
+    for(round = 0; round < 4000; round++)
+    {
+        length = (BufferIndex)(round % sizeof(piece) + 1);
+        
+        switch(round % 3)
+        {
+            case 0:
+                for(i = 0; i < length; i++)
+                    Buffer_WriteChar(&buffer, nextIn++);
+                break;
+            case 1:
+                for(i = 0; i < length; i++)
+                    piece[i] = nextIn++;
+                if(Buffer_Write(&buffer, piece, length) != length)
+                    bad++;
+                break;
+            default:
+                // The space up to the end might be less than we want
+                length = Buffer_ReserveContiguous(&buffer, &data);
+                if(length > sizeof(piece))
+                    length = sizeof(piece);
+                for(i = 0; i < length; i++)
+                    data[i] = nextIn++;
+                Buffer_CommitWrite(&buffer, length);
+                break;
+        }
+        
+        // Read it back a different way than it was written
+        switch(round % 4)
+        {
+            case 0:
+                while(Buffer_IsNotEmpty(&buffer))
+                {
+                    if(Buffer_ReadChar(&buffer) != nextOut++)
+                        bad++;
+                    moved++;
+                }
+                break;
+            case 1:
+                length = Buffer_Read(&buffer, piece, sizeof(piece));
+                for(i = 0; i < length; i++)
+                {
+                    if(piece[i] != nextOut++)
+                        bad++;
+                }
+                moved += length;
+                break;
+            case 2:
+                length = Buffer_PeekContiguous(&buffer, &data);
+                for(i = 0; i < length; i++)
+                {
+                    if(data[i] != nextOut++)
+                        bad++;
+                }
+                Buffer_CommitRead(&buffer, length);
+                moved += length;
+                break;
+            default:
+                // Leave it in to be read next time
+                break;
+        }
+    }
+    
+    Benchmark_Check("Buffer data order across wraps", bad == 0 && moved > 10 * BUFFER_SIZE);
+    Benchmark_Check("Buffer overflow", !Buffer_DidOverflow(&buffer));
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckFindByte(void)
+{
+    BufferIndex i;
+    
+    // Put the tail near the end, so the data runs past it
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    for(i = 0; i < BUFFER_SIZE - 4; i++)
+        Buffer_WriteChar(&buffer, 0);
+    for(i = 0; i < BUFFER_SIZE - 4; i++)
+        Buffer_ReadChar(&buffer);
+    
+    for(i = 0; i < 10; i++)
+        Buffer_WriteChar(&buffer, (uint8_t)('a' + i));
+    
+    Benchmark_Check("Buffer_FindByte first piece", Buffer_FindByte(&buffer, 'b') == 1);
+    Benchmark_Check("Buffer_FindByte second piece", Buffer_FindByte(&buffer, 'h') == 7);
+    Benchmark_Check("Buffer_FindByte not there", Buffer_FindByte(&buffer, 'z') == BUFFER_NOT_FOUND);
+    Benchmark_Check("Buffer_FrameAvailable", Buffer_FrameAvailable(&buffer, 'f') == 6);
+}
+
+// -----------------------------------------------------------------------------
+
+static void CountHigh(Buffer *bufferContext)
+{
+    (void)bufferContext;
+    highCount++;
+}
+
+static void CountLow(Buffer *bufferContext)
+{
+    (void)bufferContext;
+    lowCount++;
+}
+
+static void CheckWatermarks(void)
+{
+    BufferIndex i;
+    bool throttledAtHigh, throttledAboveLow;
+    
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    Buffer_SetWatermarks(&buffer, BUFFER_SIZE / 2, BUFFER_SIZE / 4);
+    Buffer_SetHighWatermarkCallback(&buffer, CountHigh);
+    Buffer_SetLowWatermarkCallback(&buffer, CountLow);
+    highCount = 0;
+    lowCount = 0;
+    
+    for(i = 0; i < BUFFER_SIZE / 2 - 1; i++)
+        Buffer_WriteChar(&buffer, 0);
+    
+    Benchmark_Check("Buffer below high watermark", highCount == 0 && !Buffer_IsThrottled(&buffer));
+    
+    // Reaching it and going past it only counts once
+    Buffer_Write(&buffer, block, 4);
+    throttledAtHigh = Buffer_IsThrottled(&buffer);
+    Benchmark_Check("Buffer high watermark", highCount == 1 && throttledAtHigh);
+    
+    Buffer_Read(&buffer, block, Buffer_GetCount(&buffer) - BUFFER_SIZE / 4 - 1);
+    throttledAboveLow = Buffer_IsThrottled(&buffer);
+    Buffer_ReadChar(&buffer);
+    
+    Benchmark_Check("Buffer low watermark", throttledAboveLow && lowCount == 1 && !Buffer_IsThrottled(&buffer));
+    
+    while(Buffer_IsNotEmpty(&buffer))
+        Buffer_ReadChar(&buffer);
+    
+    Benchmark_Check("Buffer watermark callbacks", highCount == 1 && lowCount == 1);
+}
+
+// -----------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t id;
+    uint8_t data[8];
+} Record;
+
+static void CheckQueue(void)
+{
+    static Record records[32];
+    Record in[40];
+    Record out[40];
+    Queue queue;
+    QueueIndex count;
+    uint32_t bad = 0;
+    uint32_t round, i;
+    uint32_t nextIn = 0;
+    uint32_t nextOut = 0;
+    
+    memset(in, 0, sizeof(in));
+    Queue_Init(&queue, records, sizeof(Record), 32);
+    
+    // Seven in and five out keeps the tail moving around the end
+    for(round = 0; round < 200; round++)
+    {
+        for(i = 0; i < 7; i++)
+            in[i].id = nextIn++;
+        
+        count = Queue_PushMany(&queue, in, 7);
+        
+        // Whatever didn't fit is pushed again next time
+        nextIn -= 7 - count;
+        
+        count = Queue_PopMany(&queue, out, 5);
+        for(i = 0; i < count; i++)
+        {
+            if(out[i].id != nextOut++)
+                bad++;
+        }
+        
+        if(!Queue_Pop(&queue, &out[0]) || out[0].id != nextOut++)
+            bad++;
+    }
+    
+    Benchmark_Check("Queue_PushMany/PopMany order", bad == 0 && nextOut == 1200);
+    
+    // More than the queue can ever hold. Without overwrite, only the ones that
+    // fit go in. With it, only the newest are kept.
+    for(i = 0; i < 40; i++)
+        in[i].id = i;
+    
+    Queue_Init(&queue, records, sizeof(Record), 32);
+    count = Queue_PushMany(&queue, in, 40);
+    Benchmark_Check("Queue_PushMany too many", count == Queue_GetCount(&queue) && count <= 32 && Queue_DidOverflow(&queue));
+    
+    count = Queue_PopMany(&queue, out, 40);
+    Benchmark_Check("Queue_PopMany too many", count != 0 && out[0].id == 0 && out[count - 1].id == (uint32_t)count - 1);
+    
+    Queue_InitWithOverwrite(&queue, records, sizeof(Record), 32, true);
+    Queue_PushMany(&queue, in, 40);
+    count = Queue_PopMany(&queue, out, 40);
+    Benchmark_Check("Queue_PushMany overwrite", count != 0 && out[count - 1].id == 39 && out[0].id == 40u - count);
+}
+
+// -----------------------------------------------------------------------------
+
+static void WriteReadChar(void)
+{
+    uint32_t bytes, i;
+    uint32_t sum = 0;
+    uint32_t expected = 0;
+    uint64_t start;
+    
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += BLOCK_SIZE)
+    {
+        for(i = 0; i < BLOCK_SIZE; i++)
+            Buffer_WriteChar(&buffer, (uint8_t)i);
+        
+        for(i = 0; i < BLOCK_SIZE; i++)
+            sum += Buffer_ReadChar(&buffer);
+    }
+    
+    Benchmark_Report("Buffer_WriteChar/ReadChar", TOTAL_BYTES, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    
+    for(i = 0; i < BLOCK_SIZE; i++)
+        expected += (uint8_t)i;
+    
+    Benchmark_Check("Buffer_WriteChar/ReadChar sum", sum == expected * (TOTAL_BYTES / BLOCK_SIZE));
+    benchmarkSink += sum;
+}
+
+// -----------------------------------------------------------------------------
+
+static void WriteReadBlock(void)
+{
+    uint32_t bytes, i;
+    uint32_t bad = 0;
+    uint64_t start;
+    
+    for(i = 0; i < BLOCK_SIZE; i++)
+        block[i] = (uint8_t)(i * 7);
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    
+    // Start partway in so that the blocks wrap around the end
+    Buffer_WriteChar(&buffer, 0);
+    Buffer_ReadChar(&buffer);
+    
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += BLOCK_SIZE)
+    {
+        Buffer_Write(&buffer, block, BLOCK_SIZE);
+        Buffer_Read(&buffer, block, BLOCK_SIZE);
+    }
+    
+    Benchmark_Report("Buffer_Write/Read " "(half buffer blocks)", TOTAL_BYTES / BLOCK_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    
+    // The same block went around every time, so it should still be the same
+    for(i = 0; i < BLOCK_SIZE; i++)
+    {
+        if(block[i] != (uint8_t)(i * 7))
+            bad++;
+    }
+    Benchmark_Check("Buffer_Write/Read data", bad == 0 && !Buffer_IsNotEmpty(&buffer));
+    benchmarkSink += block[0];
+}
+
+// -----------------------------------------------------------------------------
+
+static void ContiguousSpans(void)
+{
+    uint32_t bytes = 0;
+    uint32_t sum = 0;
+    uint32_t bad = 0;
+    uint64_t start;
+    uint8_t *data;
+    BufferIndex length;
+    
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    while(bytes < TOTAL_BYTES)
+    {
+        // Fill in place, then use it in place
+        length = Buffer_ReserveContiguous(&buffer, &data);
+        if(length > BLOCK_SIZE)
+            length = BLOCK_SIZE;
+        memset(data, (int)bytes, length);
+        Buffer_CommitWrite(&buffer, length);
+        
+        length = Buffer_PeekContiguous(&buffer, &data);
+        sum += data[0];
+        if(data[0] != (uint8_t)bytes || data[length - 1] != (uint8_t)bytes)
+            bad++;
+        Buffer_CommitRead(&buffer, length);
+        bytes += length;
+    }
+    
+    Benchmark_Report("Buffer_Reserve/Peek/Commit", bytes, bytes, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("Buffer_Reserve/Peek/Commit data", bad == 0 && !Buffer_IsNotEmpty(&buffer));
+    benchmarkSink += sum;
+}
+
+// -----------------------------------------------------------------------------
+
+#define LINE_LENGTH     (BLOCK_SIZE / 2)
+
+static void FrameScan(void)
+{
+    uint8_t line[LINE_LENGTH];
+    uint32_t bytes, i;
+    uint32_t sum = 0;
+    uint64_t start;
+    BufferIndex length;
+    uint8_t c;
+    
+    // Two lines per block, each ending in a '\n'
+    memset(block, 'a', sizeof(block));
+    block[LINE_LENGTH - 1] = '\n';
+    block[BLOCK_SIZE - 1] = '\n';
+    
+    Buffer_Init(&buffer, array, BUFFER_SIZE);
+    Buffer_WriteChar(&buffer, 0);
+    Buffer_ReadChar(&buffer);
+    
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += BLOCK_SIZE)
+    {
+        Buffer_Write(&buffer, block, BLOCK_SIZE);
+        
+        // The old way. Copy into a line buffer until we see the end.
+        i = 0;
+        while(Buffer_IsNotEmpty(&buffer))
+        {
+            c = Buffer_ReadChar(&buffer);
+            line[i++] = c;
+            
+            if(c == '\n')
+            {
+                sum += i;
+                i = 0;
+            }
+        }
+    }
+    
+    Benchmark_Report("lines with ReadChar", TOTAL_BYTES / LINE_LENGTH, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += BLOCK_SIZE)
+    {
+        Buffer_Write(&buffer, block, BLOCK_SIZE);
+        
+        while((length = Buffer_FrameAvailable(&buffer, '\n')) != 0)
+            sum += Buffer_Read(&buffer, line, length);
+    }
+    
+    Benchmark_Report("lines with FrameAvailable/Read", TOTAL_BYTES / LINE_LENGTH, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    
+    // Both ways should have found every line, and every byte was in one
+    Benchmark_Check("Buffer line lengths", sum == 2 * TOTAL_BYTES && line[LINE_LENGTH - 1] == '\n');
+    benchmarkSink += sum + line[0];
+}
+
+// -----------------------------------------------------------------------------
+
+static void QueueRecords(void)
+{
+    static Record records[32];
+    Record in[16];
+    Record out[16];
+    Queue queue;
+    uint32_t count, i;
+    uint32_t total = TOTAL_BYTES / sizeof(Record);
+    uint64_t start;
+    
+    uint32_t bad = 0;
+    
+    memset(in, 0, sizeof(in));
+    for(i = 0; i < 16; i++)
+        in[i].id = i;
+    
+    Queue_Init(&queue, records, sizeof(Record), 32);
+    start = Benchmark_GetTimeNs();
+    
+    for(count = 0; count < total; count += 16)
+    {
+        for(i = 0; i < 16; i++)
+            Queue_Push(&queue, &in[i]);
+        
+        for(i = 0; i < 16; i++)
+            Queue_Pop(&queue, &out[i]);
+    }
+    
+    Benchmark_Report("Queue_Push/Pop (12 byte records)", total, total * sizeof(Record), Benchmark_GetTimeNs() - start);
+    
+    for(i = 0; i < 16; i++)
+    {
+        if(out[i].id != i)
+            bad++;
+    }
+    memset(out, 0, sizeof(out));
+    
+    start = Benchmark_GetTimeNs();
+    
+    for(count = 0; count < total; count += 16)
+    {
+        Queue_PushMany(&queue, in, 16);
+        Queue_PopMany(&queue, out, 16);
+    }
+    
+    Benchmark_Report("Queue_PushMany/PopMany (12 byte records)", total, total * sizeof(Record), Benchmark_GetTimeNs() - start);
+    
+    for(i = 0; i < 16; i++)
+    {
+        if(out[i].id != i)
+            bad++;
+    }
+    Benchmark_Check("Queue records", bad == 0 && !Queue_IsNotEmpty(&queue));
+    benchmarkSink += out[0].id;
+}
+
+/*
+ End of File
+ */
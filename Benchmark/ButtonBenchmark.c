@@ -0,0 +1,273 @@
+/* *****************************************************************************
+ * @Summary Button Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File ButtonBenchmark.c
+ * 
+ * @Description
+ *      Measures the cost of one scan of a key panel. Most of the time nothing 
+ *      is pressed, and every so often one key gets pressed and held for a 
+ *      while, which is what a real panel looks like. The panel is scanned 
+ *      with Button_Tick on every key, with a ButtonGroup, and with the vertical
+ *      counter debounce. A 64 key matrix is also scanned a row at a time with
+ *      CompactButton. Every way of scanning has to see the same presses.
+ * 
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "Benchmark.h"
+#include "Button.h"
+#include "ButtonGroup.h"
+#include "CompactButton.h"
+#include "Timebase.h"
+
+// ***** Defines ***************************************************************
+
+#define TOTAL_TICKS     1000000u
+#define MATRIX_ROWS     8
+#define MATRIX_KEYS     (MATRIX_ROWS * 8)
+
+// ***** Function Prototypes ***************************************************
+
+static void RunScans(uint8_t numKeys);
+static void RunMatrixScan(void);
+static void CheckReleaseBounce(void);
+static void CountEvent(Button *buttonContext, ButtonEvent event);
+static ButtonMask GetInput(uint32_t tick, uint8_t numKeys);
+
+// ***** Global Variables ******************************************************
+
+static Button buttons[BUTTON_GROUP_SIZE];
+static ButtonGroup group;
+static CompactButton keys[MATRIX_KEYS];
+static uint32_t eventCounts[4];
+
+static const CompactButtonConfig keyConfig =
+{
+    TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(250)
+};
+
+// *****************************************************************************
+
+void ButtonBenchmark_Run(void)
+{
+    CheckReleaseBounce();
+    RunScans(8);
+    
+    if(BUTTON_GROUP_SIZE >= 24)
+        RunScans(24);
+    
+    RunMatrixScan();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void RunScans(uint8_t numKeys)
+{
+    char name[48];
+    uint32_t tick;
+    uint32_t presses = 0;
+    uint32_t singleCounts[4];
+    uint32_t rising = 0;
+    ButtonMask input;
+    ButtonMask changed;
+    uint8_t i;
+    uint64_t start;
+    
+    for(i = 0; i < numKeys; i++)
+    {
+        Button_InitWithLongPress(&buttons[i], TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(1000));
+        Button_SetCallback(&buttons[i], CountEvent);
+    }
+    
+    memset(eventCounts, 0, sizeof(eventCounts));
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+    {
+        input = GetInput(tick, numKeys);
+        
+        for(i = 0; i < numKeys; i++)
+            Button_Tick(&buttons[i], (input >> i) & 1);
+    }
+    
+    sprintf(name, "Button_Tick x %u keys", numKeys);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    memcpy(singleCounts, eventCounts, sizeof(singleCounts));
+    
+    for(i = 0; i < numKeys; i++)
+    {
+        Button_InitWithLongPress(&buttons[i], TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(1000));
+        Button_SetCallback(&buttons[i], CountEvent);
+    }
+    
+    memset(eventCounts, 0, sizeof(eventCounts));
+    ButtonGroup_Init(&group, buttons, numKeys);
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+        ButtonGroup_Tick(&group, GetInput(tick, numKeys));
+    
+    sprintf(name, "ButtonGroup_Tick, %u keys", numKeys);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    
+    // Every key press was held long enough to count, and the group only 
+    // skips the ticks that wouldn't have changed anything
+    sprintf(name, "Button events, %u keys", numKeys);
+    Benchmark_Check(name, singleCounts[BUTTON_DOWN_EVENT] == TOTAL_TICKS / 2000 &&
+        singleCounts[BUTTON_UP_EVENT] == TOTAL_TICKS / 2000);
+    sprintf(name, "ButtonGroup events, %u keys", numKeys);
+    Benchmark_Check(name, memcmp(singleCounts, eventCounts, sizeof(singleCounts)) == 0);
+    
+    for(i = 0; i < numKeys; i++)
+        presses += buttons[i].flags.shortPress;
+    
+    ButtonGroup_Init(&group, buttons, numKeys);
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+    {
+        changed = ButtonGroup_Debounce(&group, GetInput(tick, numKeys));
+        presses += changed != 0;
+        
+        // The ones that flipped and are now down were just pressed
+        rising += (changed & ButtonGroup_GetDebounced(&group)) != 0;
+    }
+    
+    sprintf(name, "ButtonGroup_Debounce, %u keys", numKeys);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    
+    sprintf(name, "ButtonGroup_Debounce presses, %u keys", numKeys);
+    Benchmark_Check(name, rising == TOTAL_TICKS / 2000);
+    benchmarkSink += presses;
+}
+
+// -----------------------------------------------------------------------------
+
+static void RunMatrixScan(void)
+{
+    char name[48];
+    uint32_t tick;
+    uint32_t presses = 0;
+    uint32_t longPresses = 0;
+    uint32_t press;
+    uint8_t row;
+    uint8_t rowInput;
+    uint8_t i;
+    uint64_t start;
+    
+    CompactButton_InitArray(keys, MATRIX_KEYS);
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+    {
+        // Same pattern as GetInput, spread over the whole matrix
+        press = (tick / 2000) % MATRIX_KEYS;
+        
+        for(row = 0; row < MATRIX_ROWS; row++)
+        {
+            if(tick % 2000 < 300 && press / 8 == row)
+                rowInput = (uint8_t)(1 << (press % 8));
+            else
+                rowInput = 0;
+            
+            CompactButton_TickRow(&keys[row * 8], &keyConfig, rowInput, 8);
+        }
+    }
+    
+    sprintf(name, "CompactButton_TickRow, %u keys", MATRIX_KEYS);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    
+    for(i = 0; i < MATRIX_KEYS; i++)
+    {
+        presses += CompactButton_GetShortPress(&keys[i]);
+        longPresses += CompactButton_GetLongPress(&keys[i]);
+    }
+    
+    // Every key got its turn, and was held past the long press each time
+    Benchmark_Check("CompactButton presses", presses == 0 && longPresses == MATRIX_KEYS);
+    benchmarkSink += presses;
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckReleaseBounce(void)
+{
+    // Pressed, then it bounces open for one tick during the release debounce
+    // and stays held
+    static const uint8_t input[] = { 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1 };
+    Button single;
+    Button sleepy;
+    uint8_t singleDowns = 0;
+    uint8_t groupDowns = 0;
+    uint8_t sleepyDowns = 0;
+    uint8_t i;
+    
+    Button_Init(&single, 2, 2);
+    Button_Init(&sleepy, 2, 2);
+    Button_Init(&buttons[0], 2, 2);
+    ButtonGroup_Init(&group, buttons, 1);
+    
+    for(i = 0; i < sizeof(input); i++)
+    {
+        Button_Tick(&single, input[i]);
+        ButtonGroup_Tick(&group, input[i]);
+        
+        // This one is only ticked while it says it needs it, or when the pin
+        // changed, like it would be with the interrupt-on-change
+        if(i > 0 && input[i] != input[i - 1])
+            Button_EdgeDetected(&sleepy);
+        
+        if(i == 0 || Button_NeedsTick(&sleepy))
+        {
+            Button_ClearEdge(&sleepy);
+            Button_Tick(&sleepy, input[i]);
+        }
+        
+        singleDowns += Button_GetButtonDownEvent(&single);
+        groupDowns += Button_GetButtonDownEvent(&buttons[0]);
+        sleepyDowns += Button_GetButtonDownEvent(&sleepy);
+        Button_ClearButtonDownFlag(&single);
+        Button_ClearButtonDownFlag(&buttons[0]);
+        Button_ClearButtonDownFlag(&sleepy);
+    }
+    
+    // Still one press that is still being held, either way
+    Benchmark_Check("Button release bounce", single.buttonState == BUTTON_DOWN && singleDowns == 1);
+    Benchmark_Check("ButtonGroup release bounce", buttons[0].buttonState == BUTTON_DOWN && groupDowns == 1);
+    Benchmark_Check("Button release bounce, woken by edges", sleepy.buttonState == BUTTON_DOWN && sleepyDowns == 1);
+    Benchmark_Check("Button held without a long press sleeps", !Button_NeedsTick(&sleepy));
+}
+
+// -----------------------------------------------------------------------------
+
+static void CountEvent(Button *buttonContext, ButtonEvent event)
+{
+    (void)buttonContext;
+    eventCounts[event]++;
+}
+
+// -----------------------------------------------------------------------------
+
+static ButtonMask GetInput(uint32_t tick, uint8_t numKeys)
+{
+    // Every 2000 ticks, hold the next key down for 300 ticks
+    uint32_t press = tick / 2000;
+    
+    if(tick % 2000 < 300)
+        return (ButtonMask)1 << (press % numKeys);
+    else
+        return 0;
+}
+
+/*
+ End of File
+ */
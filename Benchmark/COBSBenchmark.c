@@ -0,0 +1,159 @@
+/* *****************************************************************************
+ * @Summary COBS Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File COBSBenchmark.c
+ * 
+ * @Description
+ *      Sends frames through a transmit buffer and a receive buffer with COBS.
+ *      The same frames are also decoded with the kind of one byte at a time 
+ *      state machine that the COBS module replaces, to compare them.
+ * 
+*******************************************************************************/
+
+#include <string.h>
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "COBS.h"
+
+// ***** Defines ***************************************************************
+
+#define TOTAL_BYTES     (16u * 1024u * 1024u)
+#define FRAME_SIZE      100
+#define BUFFER_SIZE     128
+
+// ***** Function Prototypes ***************************************************
+
+static void MakeFrame(void);
+static void EncodeDecode(void);
+static void DecodeByteByByte(void);
+
+// ***** Global Variables ******************************************************
+
+static uint8_t txArray[BUFFER_SIZE];
+static uint8_t rxArray[BUFFER_SIZE];
+static uint8_t frame[FRAME_SIZE];
+static uint8_t decoded[FRAME_SIZE];
+static Buffer txBuffer;
+static Buffer rxBuffer;
+
+// *****************************************************************************
+
+void COBSBenchmark_Run(void)
+{
+    MakeFrame();
+    EncodeDecode();
+    DecodeByteByByte();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void MakeFrame(void)
+{
+    uint8_t i;
+    
+    // Mostly data with a zero every so often, like a packet with some fields
+    for(i = 0; i < FRAME_SIZE; i++)
+        frame[i] = (i % 23 == 0) ? 0 : (uint8_t)(i * 7 + 1);
+}
+
+// -----------------------------------------------------------------------------
+
+static void EncodeDecode(void)
+{
+    COBSDecoder decoder;
+    uint32_t bytes;
+    uint32_t sum = 0;
+    uint64_t start;
+    uint8_t *data;
+    BufferIndex length;
+    
+    Buffer_Init(&txBuffer, txArray, BUFFER_SIZE);
+    Buffer_Init(&rxBuffer, rxArray, BUFFER_SIZE);
+    COBS_InitDecoder(&decoder, decoded, FRAME_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += FRAME_SIZE)
+    {
+        COBS_EncodeFrame(&txBuffer, frame, FRAME_SIZE);
+        
+        // Pretend the UART moved it across
+        while((length = Buffer_PeekContiguous(&txBuffer, &data)) != 0)
+        {
+            Buffer_Write(&rxBuffer, data, length);
+            Buffer_CommitRead(&txBuffer, length);
+        }
+        
+        sum += COBS_Decode(&decoder, &rxBuffer);
+    }
+    
+    Benchmark_Report("COBS_EncodeFrame/Decode (100 bytes)", TOTAL_BYTES / FRAME_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    
+    // Every frame should have come back whole, and the same as it went in
+    Benchmark_Check("COBS round trip length", sum == (TOTAL_BYTES + FRAME_SIZE - 1) / FRAME_SIZE * FRAME_SIZE);
+    Benchmark_Check("COBS round trip data", memcmp(decoded, frame, FRAME_SIZE) == 0);
+    Benchmark_Check("COBS dropped frame", !COBS_DidDropFrame(&decoder));
+    benchmarkSink += sum + decoded[1];
+}
+
+// -----------------------------------------------------------------------------
+
+static void DecodeByteByByte(void)
+{
+    uint32_t bytes;
+    uint32_t sum = 0;
+    uint64_t start;
+    BufferIndex length = 0;
+    uint8_t code = 0;
+    uint8_t remaining = 0;
+    uint8_t c;
+    
+    Buffer_Init(&txBuffer, txArray, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += FRAME_SIZE)
+    {
+        COBS_EncodeFrame(&txBuffer, frame, FRAME_SIZE);
+        
+        while(Buffer_IsNotEmpty(&txBuffer))
+        {
+            c = Buffer_ReadChar(&txBuffer);
+            
+            if(c == 0)
+            {
+                sum += length;
+                length = 0;
+                code = 0;
+                remaining = 0;
+            }
+            else if(remaining == 0)
+            {
+                if(code != 0 && code != 0xFF)
+                    decoded[length++] = 0;
+                code = c;
+                remaining = c - 1;
+            }
+            else
+            {
+                decoded[length++] = c;
+                remaining--;
+            }
+        }
+    }
+    
+    Benchmark_Report("COBS_EncodeFrame/ReadChar decode", TOTAL_BYTES / FRAME_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("COBS byte decode length", sum == (TOTAL_BYTES + FRAME_SIZE - 1) / FRAME_SIZE * FRAME_SIZE);
+    Benchmark_Check("COBS byte decode data", memcmp(decoded, frame, FRAME_SIZE) == 0);
+    benchmarkSink += sum + decoded[1];
+}
+
+/*
+ End of File
+ */
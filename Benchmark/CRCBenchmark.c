@@ -0,0 +1,200 @@
+/* *****************************************************************************
+ * @Summary CRC Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File CRCBenchmark.c
+ * 
+ * @Description
+ *      Times the CRC16 and CRC32 on their own, then checks frames that are 
+ *      sitting in a receive buffer. The first way reads each frame out one 
+ *      byte at a time and then goes over it again for the CRC. With 
+ *      BUFFER_ENABLE_CRC, the frame is checked right in the buffer and then 
+ *      read out in one piece.
+ * 
+*******************************************************************************/
+
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "CRC.h"
+
+// ***** Defines ***************************************************************
+
+#define TOTAL_BYTES     (16u * 1024u * 1024u)
+#define FRAME_SIZE      64
+#define BUFFER_SIZE     128
+
+// ***** Function Prototypes ***************************************************
+
+static void MakeFrame(void);
+static void RunStandalone(void);
+static void ReadThenCheck(void);
+static void CheckLongSpan(void);
+
+#ifdef BUFFER_ENABLE_CRC
+static void CheckInPlace(void);
+#endif
+
+// ***** Global Variables ******************************************************
+
+static uint8_t frame[FRAME_SIZE];
+static uint8_t received[FRAME_SIZE];
+static uint8_t rxArray[BUFFER_SIZE];
+static Buffer rxBuffer;
+
+// *****************************************************************************
+
+void CRCBenchmark_Run(void)
+{
+    MakeFrame();
+    RunStandalone();
+    ReadThenCheck();
+    CheckLongSpan();
+    
+#ifdef BUFFER_ENABLE_CRC
+    CheckInPlace();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void MakeFrame(void)
+{
+    static const uint8_t checkString[] = "123456789";
+    uint8_t i;
+    uint16_t crc;
+    
+    // The standard check values, and the same thing fed in two pieces
+    Benchmark_Check("CRC16 check value", CRC16_Update(CRC16_INITIAL, checkString, 9) == 0x29B1);
+    Benchmark_Check("CRC32 check value", CRC32_FINAL(CRC32_Update(CRC32_INITIAL, checkString, 9)) == 0xCBF43926UL);
+    Benchmark_Check("CRC16 in pieces", CRC16_Update(CRC16_Update(CRC16_INITIAL, checkString, 4), &checkString[4], 5) == 0x29B1);
+    
+    for(i = 0; i < FRAME_SIZE - 2; i++)
+        frame[i] = (uint8_t)(i * 7 + 1);
+    
+    // The CRC goes on the end, high byte first
+    crc = CRC16_Update(CRC16_INITIAL, frame, FRAME_SIZE - 2);
+    frame[FRAME_SIZE - 2] = (uint8_t)(crc >> 8);
+    frame[FRAME_SIZE - 1] = (uint8_t)crc;
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckLongSpan(void)
+{
+    // Longer than a uint16_t can count, like a span of a 32 bit Buffer
+    static uint8_t big[70000UL];
+    uint32_t i;
+    uint16_t crc16 = CRC16_INITIAL;
+    uint32_t crc32 = CRC32_INITIAL;
+    
+    for(i = 0; i < sizeof(big); i++)
+    {
+        big[i] = (uint8_t)(i ^ (i >> 8));
+        crc16 = CRC16_UpdateChar(crc16, big[i]);
+        crc32 = CRC32_UpdateChar(crc32, big[i]);
+    }
+    
+    Benchmark_Check("CRC16 past 64K", CRC16_Update(CRC16_INITIAL, big, sizeof(big)) == crc16);
+    Benchmark_Check("CRC32 past 64K", CRC32_Update(CRC32_INITIAL, big, sizeof(big)) == crc32);
+}
+
+// -----------------------------------------------------------------------------
+
+static void RunStandalone(void)
+{
+    uint32_t bytes;
+    uint16_t crc16 = CRC16_INITIAL;
+    uint32_t crc32 = CRC32_INITIAL;
+    uint64_t start;
+    
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += FRAME_SIZE)
+        crc16 = CRC16_Update(crc16, frame, FRAME_SIZE);
+    
+    Benchmark_Report("CRC16_Update (64 bytes)", TOTAL_BYTES / FRAME_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += FRAME_SIZE)
+        crc32 = CRC32_Update(crc32, frame, FRAME_SIZE);
+    
+    Benchmark_Report("CRC32_Update (64 bytes)", TOTAL_BYTES / FRAME_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    benchmarkSink += crc16 + CRC32_FINAL(crc32);
+}
+
+// -----------------------------------------------------------------------------
+
+static void ReadThenCheck(void)
+{
+    uint32_t bytes;
+    uint32_t good = 0;
+    uint64_t start;
+    uint8_t i;
+    
+    Buffer_Init(&rxBuffer, rxArray, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += FRAME_SIZE)
+    {
+        // Pretend the UART put it there
+        Buffer_Write(&rxBuffer, frame, FRAME_SIZE);
+        
+        for(i = 0; i < FRAME_SIZE; i++)
+            received[i] = Buffer_ReadChar(&rxBuffer);
+        
+        // A good frame with its CRC on the end comes out to zero
+        if(CRC16_Update(CRC16_INITIAL, received, FRAME_SIZE) == 0)
+            good++;
+    }
+    
+    Benchmark_Report("ReadChar, then CRC16 (64 bytes)", TOTAL_BYTES / FRAME_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("CRC16 of each frame", good == TOTAL_BYTES / FRAME_SIZE);
+    benchmarkSink += good;
+}
+
+// -----------------------------------------------------------------------------
+
+#ifdef BUFFER_ENABLE_CRC
+static void CheckInPlace(void)
+{
+    uint32_t bytes;
+    uint32_t good = 0;
+    uint64_t start;
+    
+    Buffer_Init(&rxBuffer, rxArray, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(bytes = 0; bytes < TOTAL_BYTES; bytes += FRAME_SIZE)
+    {
+        Buffer_Write(&rxBuffer, frame, FRAME_SIZE);
+        
+        if(Buffer_CRC16(&rxBuffer, FRAME_SIZE, CRC16_INITIAL) == 0)
+        {
+            Buffer_Read(&rxBuffer, received, FRAME_SIZE);
+            good++;
+        }
+        else
+            Buffer_CommitRead(&rxBuffer, FRAME_SIZE);
+    }
+    
+    Benchmark_Report("Buffer_CRC16 in place, then Read", TOTAL_BYTES / FRAME_SIZE, TOTAL_BYTES, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("Buffer_CRC16 of each frame", good == TOTAL_BYTES / FRAME_SIZE);
+    
+    // The running CRC of one more frame, which ends with its own CRC
+    Buffer_ResetWriteCRC(&rxBuffer);
+    Buffer_Write(&rxBuffer, frame, FRAME_SIZE);
+    Benchmark_Check("Buffer_GetWriteCRC", Buffer_GetWriteCRC(&rxBuffer) == 0);
+    benchmarkSink += good;
+}
+#endif
+
+/*
+ End of File
+ */
@@ -0,0 +1,134 @@
+/* *****************************************************************************
+ * @Summary Double Buffer Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File DoubleBufferBenchmark.c
+ * 
+ * @Description
+ *      Collects ADC samples and adds up every block of them. The first way 
+ *      puts each sample in a Buffer and reads them back out one at a time. 
+ *      The second way writes them into a DoubleBuffer and adds up each block 
+ *      right where it is.
+ * 
+*******************************************************************************/
+
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "DoubleBuffer.h"
+
+// ***** Defines ***************************************************************
+
+#define BLOCK_SIZE      64
+#define NUM_BLOCKS      2
+#define TOTAL_SAMPLES   (16u * 1024u * 1024u)
+
+// ***** Function Prototypes ***************************************************
+
+static void RingSamples(void);
+static void BlockSamples(void);
+
+// ***** Global Variables ******************************************************
+
+// Both ways should add up to the same thing
+static uint32_t ringSum;
+
+static uint8_t ringArray[BLOCK_SIZE * NUM_BLOCKS];
+static Buffer ring;
+
+static uint8_t blockMemory[BLOCK_SIZE * NUM_BLOCKS];
+static DoubleBuffer blocks;
+
+// *****************************************************************************
+
+void DoubleBufferBenchmark_Run(void)
+{
+    RingSamples();
+    BlockSamples();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void RingSamples(void)
+{
+    uint32_t i;
+    uint32_t sum = 0;
+    uint8_t j;
+    uint64_t start;
+    
+    Buffer_Init(&ring, ringArray, sizeof(ringArray));
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_SAMPLES; i++)
+    {
+        Buffer_WriteChar(&ring, (uint8_t)i);
+        
+        if(Buffer_GetCount(&ring) == BLOCK_SIZE)
+        {
+            for(j = 0; j < BLOCK_SIZE; j++)
+                sum += Buffer_ReadChar(&ring);
+        }
+    }
+    
+    Benchmark_Report("Buffer samples, read per byte", TOTAL_SAMPLES, TOTAL_SAMPLES, Benchmark_GetTimeNs() - start);
+    ringSum = sum;
+    benchmarkSink += sum;
+}
+
+// -----------------------------------------------------------------------------
+
+static void BlockSamples(void)
+{
+    uint32_t i;
+    uint32_t sum = 0;
+    uint8_t *block;
+    uint32_t blocksSeen = 0;
+    uint32_t bad = 0;
+    uint8_t j;
+    uint64_t start;
+    
+    DoubleBuffer_Init(&blocks, blockMemory, BLOCK_SIZE, NUM_BLOCKS);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_SAMPLES; i++)
+    {
+        DoubleBuffer_WriteChar(&blocks, (uint8_t)i);
+        block = DoubleBuffer_GetReadyBlock(&blocks);
+        
+        if(block)
+        {
+            for(j = 0; j < BLOCK_SIZE; j++)
+                sum += block[j];
+            
+            // Each block starts with the sample that was its index
+            bad += block[0] != (uint8_t)(blocksSeen * BLOCK_SIZE);
+            blocksSeen++;
+            DoubleBuffer_ReleaseBlock(&blocks);
+        }
+    }
+    
+    Benchmark_Report("DoubleBuffer samples, block at a time", TOTAL_SAMPLES, TOTAL_SAMPLES, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("DoubleBuffer blocks", bad == 0 && blocksSeen == TOTAL_SAMPLES / BLOCK_SIZE);
+    Benchmark_Check("DoubleBuffer sum", sum == ringSum);
+    Benchmark_Check("DoubleBuffer overrun", !DoubleBuffer_DidOverrun(&blocks));
+    benchmarkSink += sum;
+    
+    // Nobody processes anything, so the last block has nowhere to go
+    DoubleBuffer_Init(&blocks, blockMemory, BLOCK_SIZE, NUM_BLOCKS);
+    
+    for(i = 0; i < BLOCK_SIZE * NUM_BLOCKS; i++)
+        DoubleBuffer_WriteChar(&blocks, (uint8_t)i);
+    
+    Benchmark_Check("DoubleBuffer overrun when full", DoubleBuffer_DidOverrun(&blocks) && 
+        DoubleBuffer_GetReadyCount(&blocks) == NUM_BLOCKS - 1);
+}
+
+/*
+ End of File
+ */
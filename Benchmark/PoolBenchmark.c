@@ -0,0 +1,156 @@
+/* *****************************************************************************
+ * @Summary Pool Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File PoolBenchmark.c
+ * 
+ * @Description
+ *      Passes a frame from a receiver, through a handler, to a transmitter. 
+ *      The first way goes through byte buffers and copies the frame into an 
+ *      array on the stack and back out again. The second way fills a pool 
+ *      block and only hands the pointer along. The frame is filled the same 
+ *      way both times, so the difference is all of the copying.
+ * 
+*******************************************************************************/
+
+#include <string.h>
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "Queue.h"
+#include "Pool.h"
+
+// ***** Defines ***************************************************************
+
+#define FRAME_SIZE      64
+#define BUFFER_SIZE     128
+#define NUM_BLOCKS      4
+#define TOTAL_FRAMES    (1024u * 1024u)
+
+// ***** Function Prototypes ***************************************************
+
+static void CopyFrames(void);
+static void PassBlocks(void);
+
+// ***** Global Variables ******************************************************
+
+static uint8_t frame[FRAME_SIZE];
+static uint8_t rxArray[BUFFER_SIZE];
+static uint8_t txArray[BUFFER_SIZE];
+static Buffer rxBuffer;
+static Buffer txBuffer;
+
+static POOL_DECLARE(frameMemory, FRAME_SIZE, NUM_BLOCKS);
+static Pool framePool;
+static void *rxPointers[NUM_BLOCKS + 1];
+static void *txPointers[NUM_BLOCKS + 1];
+static Queue rxQueue;
+static Queue txQueue;
+
+// *****************************************************************************
+
+void PoolBenchmark_Run(void)
+{
+    uint8_t i;
+    
+    for(i = 0; i < FRAME_SIZE; i++)
+        frame[i] = (uint8_t)(i * 3 + 1);
+    
+    CopyFrames();
+    PassBlocks();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void CopyFrames(void)
+{
+    uint8_t handlerFrame[FRAME_SIZE];
+    uint32_t sum = 0;
+    uint32_t i;
+    uint64_t start;
+    
+    Buffer_Init(&rxBuffer, rxArray, BUFFER_SIZE);
+    Buffer_Init(&txBuffer, txArray, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_FRAMES; i++)
+    {
+        // Receiver
+        Buffer_Write(&rxBuffer, frame, FRAME_SIZE);
+        
+        // Handler
+        Buffer_Read(&rxBuffer, handlerFrame, FRAME_SIZE);
+        handlerFrame[0]++;
+        Buffer_Write(&txBuffer, handlerFrame, FRAME_SIZE);
+        
+        // Transmitter
+        sum += txArray[i % BUFFER_SIZE];
+        Buffer_CommitRead(&txBuffer, FRAME_SIZE);
+    }
+    
+    Benchmark_Report("frame copied through Buffers", TOTAL_FRAMES, (uint64_t)TOTAL_FRAMES * FRAME_SIZE, Benchmark_GetTimeNs() - start);
+    benchmarkSink += sum;
+}
+
+// -----------------------------------------------------------------------------
+
+static void PassBlocks(void)
+{
+    uint8_t *block;
+    uint32_t sum = 0;
+    uint32_t bad = 0;
+    uint16_t count = 0;
+    uint32_t i;
+    uint64_t start;
+    
+    Pool_Init(&framePool, frameMemory, FRAME_SIZE, NUM_BLOCKS);
+    Queue_InitPointers(&rxQueue, rxPointers, NUM_BLOCKS + 1);
+    Queue_InitPointers(&txQueue, txPointers, NUM_BLOCKS + 1);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_FRAMES; i++)
+    {
+        // Receiver
+        block = (uint8_t *)Pool_Alloc(&framePool);
+        memcpy(block, frame, FRAME_SIZE);
+        Queue_PushPointer(&rxQueue, block);
+        
+        // Handler
+        block = (uint8_t *)Queue_PopPointer(&rxQueue);
+        block[0]++;
+        Queue_PushPointer(&txQueue, block);
+        
+        // Transmitter
+        block = (uint8_t *)Queue_PopPointer(&txQueue);
+        sum += block[i % FRAME_SIZE];
+        bad += block[0] != (uint8_t)(frame[0] + 1);
+        bad += !Pool_Free(&framePool, block);
+    }
+    
+    Benchmark_Report("frame passed as a Pool block", TOTAL_FRAMES, (uint64_t)TOTAL_FRAMES * FRAME_SIZE, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("Pool frame handoff", bad == 0 && Pool_GetFreeCount(&framePool) == NUM_BLOCKS);
+    
+    // Something that isn't the start of one of our blocks, or a block that 
+    // was already given back, has to be turned away
+    block = (uint8_t *)Pool_Alloc(&framePool);
+    Benchmark_Check("Pool_Free inside a block", !Pool_Free(&framePool, block + 1));
+    Benchmark_Check("Pool_Free", Pool_Free(&framePool, block));
+    Benchmark_Check("Pool_Free twice", !Pool_Free(&framePool, block));
+    Benchmark_Check("Pool_Free not ours", !Pool_Free(&framePool, frame));
+    
+    while(Pool_Alloc(&framePool) != 0)
+        count++;
+    
+    Benchmark_Check("Pool block count", count == NUM_BLOCKS);
+    benchmarkSink += sum + Pool_GetMinFreeCount(&framePool);
+}
+
+/*
+ End of File
+ */
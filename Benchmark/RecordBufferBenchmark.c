@@ -0,0 +1,177 @@
+/* *****************************************************************************
+ * @Summary Record Buffer Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File RecordBufferBenchmark.c
+ * 
+ * @Description
+ *      Writes small log records and reads them back out. The atomic variant
+ *      of the benchmark builds this with C11 atomics so that both ways of 
+ *      claiming space can be compared. An operation is one record. Before
+ *      any of that, the order and contents of the records are checked.
+ * 
+*******************************************************************************/
+
+#include <string.h>
+#include "Benchmark.h"
+#include "RecordBuffer.h"
+
+// ***** Defines ***************************************************************
+
+#define RECORD_SIZE     8
+#define BUFFER_SIZE     256
+#define TOTAL_RECORDS   (16u * 1024u * 1024u)
+
+// ***** Function Prototypes ***************************************************
+
+static void WriteRead(void);
+static void ReserveInPlace(void);
+static void CheckOrder(void);
+
+// ***** Global Variables ******************************************************
+
+static uint8_t recordArray[BUFFER_SIZE];
+static RecordBuffer recordBuffer;
+
+// *****************************************************************************
+
+void RecordBufferBenchmark_Run(void)
+{
+    CheckOrder();
+    WriteRead();
+    ReserveInPlace();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void WriteRead(void)
+{
+    uint8_t record[RECORD_SIZE];
+    uint8_t out[RECORD_SIZE];
+    uint32_t sum = 0;
+    uint32_t bad = 0;
+    uint32_t i;
+    uint64_t start;
+    
+    memset(record, 0x5A, RECORD_SIZE);
+    RecordBuffer_Init(&recordBuffer, recordArray, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_RECORDS; i++)
+    {
+        record[0] = (uint8_t)i;
+        RecordBuffer_Write(&recordBuffer, record, RECORD_SIZE);
+        sum += RecordBuffer_Read(&recordBuffer, out, RECORD_SIZE) + out[0];
+        bad += out[0] != (uint8_t)i;
+    }
+    
+    Benchmark_Report("RecordBuffer_Write/Read (8 byte records)", TOTAL_RECORDS, (uint64_t)TOTAL_RECORDS * RECORD_SIZE, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("RecordBuffer_Write/Read", bad == 0 && sum != 0);
+    benchmarkSink += sum;
+}
+
+// -----------------------------------------------------------------------------
+
+static void ReserveInPlace(void)
+{
+    uint8_t *record;
+    uint8_t length;
+    uint32_t sum = 0;
+    uint32_t bad = 0;
+    uint32_t i;
+    uint64_t start;
+    
+    RecordBuffer_Init(&recordBuffer, recordArray, BUFFER_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_RECORDS; i++)
+    {
+        record = RecordBuffer_Reserve(&recordBuffer, RECORD_SIZE);
+        record[0] = (uint8_t)i;
+        RecordBuffer_Commit(&recordBuffer, record);
+        
+        record = RecordBuffer_Peek(&recordBuffer, &length);
+        sum += record[0] + length;
+        bad += record[0] != (uint8_t)i || length != RECORD_SIZE;
+        RecordBuffer_Release(&recordBuffer);
+    }
+    
+    Benchmark_Report("RecordBuffer_Reserve/Commit/Peek/Release", TOTAL_RECORDS, (uint64_t)TOTAL_RECORDS * RECORD_SIZE, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("RecordBuffer_Reserve/Peek", bad == 0);
+    benchmarkSink += sum;
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckOrder(void)
+{
+    uint8_t record[32];
+    uint8_t out[32];
+    uint8_t *first;
+    uint8_t *second;
+    uint8_t length;
+    uint8_t written = 0;
+    uint8_t read = 0;
+    uint16_t round;
+    uint8_t i;
+    bool ok = true;
+    
+    RecordBuffer_Init(&recordBuffer, recordArray, BUFFER_SIZE);
+    
+    // Fill it up with records of different lengths, then drain it. The 
+    // lengths don't line up with the array, so it wraps a different way 
+    // every time.
+    for(round = 0; round < 1000 && ok; round++)
+    {
+        while(true)
+        {
+            length = (uint8_t)(1 + (written * 7 + round) % sizeof(record));
+            
+            for(i = 0; i < length; i++)
+                record[i] = (uint8_t)(written + i);
+            
+            if(!RecordBuffer_Write(&recordBuffer, record, length))
+                break;
+            
+            written++;
+        }
+        
+        ok = RecordBuffer_DidOverflow(&recordBuffer);
+        
+        while(ok && RecordBuffer_IsNotEmpty(&recordBuffer))
+        {
+            length = RecordBuffer_Read(&recordBuffer, out, sizeof(out));
+            ok = length == (uint8_t)(1 + (read * 7 + round) % sizeof(record));
+            
+            for(i = 0; ok && i < length; i++)
+                ok = out[i] == (uint8_t)(read + i);
+            
+            read++;
+        }
+        ok = ok && read == written;
+    }
+    Benchmark_Check("RecordBuffer order and contents", ok);
+    
+    // A record committed out of order has to wait for the one in front of it
+    first = RecordBuffer_Reserve(&recordBuffer, 1);
+    second = RecordBuffer_Reserve(&recordBuffer, 1);
+    first[0] = 1;
+    second[0] = 2;
+    RecordBuffer_Commit(&recordBuffer, second);
+    ok = RecordBuffer_Peek(&recordBuffer, &length) == 0;
+    RecordBuffer_Commit(&recordBuffer, first);
+    ok = ok && RecordBuffer_Read(&recordBuffer, out, sizeof(out)) == 1 && out[0] == 1;
+    ok = ok && RecordBuffer_Read(&recordBuffer, out, sizeof(out)) == 1 && out[0] == 2;
+    Benchmark_Check("RecordBuffer commit order", ok);
+}
+
+/*
+ End of File
+ */
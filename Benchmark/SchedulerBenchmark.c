@@ -0,0 +1,253 @@
+/* *****************************************************************************
+ * @Summary Scheduler Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File SchedulerBenchmark.c
+ * 
+ * @Description
+ *      A handful of receive buffers where data only shows up every so often,
+ *      like a few slow serial ports. The superloop checks all of them on 
+ *      every pass. The scheduler only runs the task for the buffer that got
+ *      something. An operation is one pass of the main loop. Both have to 
+ *      read every byte. The order the tasks run in is also checked.
+ * 
+*******************************************************************************/
+
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "Scheduler.h"
+
+// ***** Defines ***************************************************************
+
+#define NUM_BUFFERS     8
+#define BUFFER_SIZE     32
+#define TOTAL_PASSES    (4u * 1024u * 1024u)
+
+// One byte lands somewhere every this many passes
+#define DATA_INTERVAL   16
+
+// ***** Function Prototypes ***************************************************
+
+static void CheckRunOrder(void);
+static void OrderTask(void *taskContext);
+static void CheckTimerSource(void);
+static void InitBuffers(void);
+static void Superloop(void);
+static void Scheduled(void);
+static void ReadTask(void *taskContext);
+
+// ***** Global Variables ******************************************************
+
+static uint8_t arrays[NUM_BUFFERS][BUFFER_SIZE];
+static Buffer buffers[NUM_BUFFERS];
+static Scheduler scheduler;
+static uint32_t received;
+static uint32_t expectedReceived;
+static uint8_t order[8];
+static uint8_t numOrdered;
+static Timer timer;
+
+// *****************************************************************************
+
+void SchedulerBenchmark_Run(void)
+{
+    CheckRunOrder();
+    CheckTimerSource();
+    Superloop();
+    Scheduled();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckRunOrder(void)
+{
+    // Priority 1 only gets made ready by the task at 5
+    static const uint8_t priorities[5] = { 5, 2, 7, 0, 1 };
+    uint8_t i;
+    bool ranAll, ranAgain;
+    
+    Scheduler_Init(&scheduler);
+    
+    for(i = 0; i < 5; i++)
+        Scheduler_AddTask(&scheduler, priorities[i], OrderTask, (void *)&priorities[i]);
+    
+    numOrdered = 0;
+    Scheduler_SetReady(&scheduler, 7);
+    Scheduler_SetReady(&scheduler, 5);
+    Scheduler_SetReady(&scheduler, 0);
+    Scheduler_SetReady(&scheduler, 2);
+    
+    // Being made ready twice still only runs once
+    Scheduler_SetReady(&scheduler, 2);
+    
+    while(Scheduler_RunNext(&scheduler))
+        ;
+    
+    // The one made ready while 5 was running goes before 7
+    ranAll = numOrdered == 5 && order[0] == 0 && order[1] == 2 && 
+        order[2] == 5 && order[3] == 1 && order[4] == 7;
+    
+    // With 1 gone, 5 still readies it, but nothing runs
+    Scheduler_RemoveTask(&scheduler, 1);
+    numOrdered = 0;
+    Scheduler_SetReady(&scheduler, 5);
+    
+    while(Scheduler_RunNext(&scheduler))
+        ;
+    
+    ranAgain = numOrdered == 1 && order[0] == 5;
+    
+    Benchmark_Check("Scheduler run order", ranAll);
+    Benchmark_Check("Scheduler removed task", ranAgain);
+}
+
+// -----------------------------------------------------------------------------
+
+static void OrderTask(void *taskContext)
+{
+    uint8_t priority = *(const uint8_t *)taskContext;
+    
+    if(numOrdered < sizeof(order))
+        order[numOrdered++] = priority;
+    
+    if(priority == 5)
+        Scheduler_SetReady(&scheduler, 1);
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckTimerSource(void)
+{
+    static const uint8_t priority = 3;
+    uint8_t i;
+    bool ranOnce;
+    
+    Scheduler_Init(&scheduler);
+    Scheduler_AddTask(&scheduler, priority, OrderTask, (void *)&priority);
+    
+    Timer_Init(&timer, 2);
+    Timer_SetPeriodic(&timer, true);
+    Scheduler_ReadyOnTimer(&scheduler, priority, &timer);
+    Timer_Start(&timer);
+    
+    // It finishes three times before the task gets a chance to run
+    for(i = 0; i < 6; i++)
+        Timer_Tick(&timer);
+    
+    numOrdered = 0;
+    while(Scheduler_RunNext(&scheduler))
+        ;
+    
+    ranOnce = numOrdered == 1;
+    Benchmark_Check("Scheduler timer task", ranOnce);
+    Benchmark_Check("Scheduler timer missed", Timer_GetMissedExpirations(&timer) == 2);
+    
+    Timer_Stop(&timer);
+}
+
+// -----------------------------------------------------------------------------
+
+static void InitBuffers(void)
+{
+    uint8_t i;
+    
+    for(i = 0; i < NUM_BUFFERS; i++)
+        Buffer_Init(&buffers[i], arrays[i], BUFFER_SIZE);
+}
+
+// -----------------------------------------------------------------------------
+
+static void Superloop(void)
+{
+    uint32_t pass;
+    uint8_t i;
+    uint64_t start;
+    
+    InitBuffers();
+    received = 0;
+    expectedReceived = 0;
+    
+    for(pass = 0; pass < TOTAL_PASSES; pass += DATA_INTERVAL)
+        expectedReceived += (uint8_t)pass;
+    
+    start = Benchmark_GetTimeNs();
+    
+    for(pass = 0; pass < TOTAL_PASSES; pass++)
+    {
+        if(pass % DATA_INTERVAL == 0)
+            Buffer_WriteChar(&buffers[(pass / DATA_INTERVAL) % NUM_BUFFERS], (uint8_t)pass);
+        
+        for(i = 0; i < NUM_BUFFERS; i++)
+        {
+            while(Buffer_IsNotEmpty(&buffers[i]))
+                received += Buffer_ReadChar(&buffers[i]);
+        }
+    }
+    
+    Benchmark_Report("superloop polling 8 buffers", TOTAL_PASSES, 0, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("superloop received", received == expectedReceived);
+    benchmarkSink += received;
+}
+
+// -----------------------------------------------------------------------------
+
+static void Scheduled(void)
+{
+    uint32_t pass;
+    uint8_t i;
+    uint64_t start;
+    bool added = true;
+    
+    InitBuffers();
+    Scheduler_Init(&scheduler);
+    
+    for(i = 0; i < NUM_BUFFERS; i++)
+    {
+        added = Scheduler_AddTask(&scheduler, i, ReadTask, &buffers[i]) && added;
+        added = Scheduler_ReadyOnData(&scheduler, i, &buffers[i]) && added;
+    }
+    
+    Benchmark_Check("Scheduler buffer tasks", added);
+    
+    received = 0;
+    start = Benchmark_GetTimeNs();
+    
+    for(pass = 0; pass < TOTAL_PASSES; pass++)
+    {
+        if(pass % DATA_INTERVAL == 0)
+            Buffer_WriteChar(&buffers[(pass / DATA_INTERVAL) % NUM_BUFFERS], (uint8_t)pass);
+        
+        while(Scheduler_RunNext(&scheduler))
+            ;
+    }
+    
+    Benchmark_Report("Scheduler_RunNext, 8 buffer tasks", TOTAL_PASSES, 0, Benchmark_GetTimeNs() - start);
+    Benchmark_Check("Scheduler received", received == expectedReceived);
+    benchmarkSink += received;
+    
+    // Leave the buffers the way the other benchmarks expect them
+    for(i = 0; i < NUM_BUFFERS; i++)
+        Buffer_SetDataAvailableCallback(&buffers[i], 0);
+}
+
+// -----------------------------------------------------------------------------
+
+static void ReadTask(void *taskContext)
+{
+    Buffer *buffer = (Buffer *)taskContext;
+    
+    // Read until it's empty, or we won't hear about what's left
+    while(Buffer_IsNotEmpty(buffer))
+        received += Buffer_ReadChar(buffer);
+}
+
+/*
+ End of File
+ */
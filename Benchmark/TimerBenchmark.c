@@ -0,0 +1,323 @@
+/* *****************************************************************************
+ * @Summary Timer Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File TimerBenchmark.c
+ * 
+ * @Description
+ *      Measures the cost of one tick with different numbers of timers. Every 
+ *      timer restarts itself from its callback so they all keep running. The
+ *      same timers are run with Timer_Tick on each one, and then with a 
+ *      TimerManager. Then the same thing again with periodic timers, which 
+ *      reload themselves instead of being restarted. Both ways have to finish
+ *      every timer the same number of times. A few timers are also run by 
+ *      hand to check the order they finish in and the catch up after a sleep.
+ * 
+*******************************************************************************/
+
+#include <stdio.h>
+#include "Benchmark.h"
+#include "Timer.h"
+#include "TimerManager.h"
+#include "Timebase.h"
+
+// ***** Defines ***************************************************************
+
+#define MAX_TIMERS      128
+#define TOTAL_TICKS     200000u
+
+// ***** Function Prototypes ***************************************************
+
+static void CheckOrder(void);
+static void CheckCatchUp(void);
+static void CheckTicksClamp(void);
+static void RecordOrder(Timer *timer);
+static uint32_t ExpectedExpirations(uint16_t numTimers);
+static void RunTicks(uint16_t numTimers);
+static void RunPeriodicTicks(uint16_t numTimers);
+static void CountExpiration(Timer *timer);
+static void RestartTimer(Timer *timer);
+static void RestartManagedTimer(Timer *timer);
+
+// ***** Global Variables ******************************************************
+
+static Timer timers[MAX_TIMERS];
+static TimerManager manager;
+static uint32_t expirations;
+static uint8_t order[8];
+static uint8_t numOrdered;
+
+// *****************************************************************************
+
+void TimerBenchmark_Run(void)
+{
+    CheckOrder();
+    CheckCatchUp();
+    CheckTicksClamp();
+    RunTicks(1);
+    RunTicks(8);
+    RunTicks(64);
+    RunTicks(128);
+    RunPeriodicTicks(64);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckOrder(void)
+{
+    static const TimerCount periods[4] = { 5, 3, 8, 3 };
+    uint8_t i;
+    bool ticksUntilRight, remainingRight;
+    
+    TimerManager_Init(&manager);
+    
+    for(i = 0; i < 4; i++)
+    {
+        Timer_Init(&timers[i], periods[i]);
+        Timer_SetFinishedCallback(&timers[i], RecordOrder);
+        TimerManager_StartTimer(&manager, &timers[i]);
+    }
+    
+    ticksUntilRight = TimerManager_GetTicksUntilNextExpiry(&manager) == 3;
+    remainingRight = TimerManager_GetTicksRemaining(&manager, &timers[2]) == 8 &&
+        TimerManager_GetTicksRemaining(&manager, &timers[0]) == 5;
+    
+    numOrdered = 0;
+    for(i = 0; i < 3; i++)
+        TimerManager_Tick(&manager);
+    
+    // The two that finish on the same tick go in the order they were started
+    ticksUntilRight = ticksUntilRight && numOrdered == 2 &&
+        TimerManager_GetTicksUntilNextExpiry(&manager) == 2;
+    
+    for(i = 0; i < 10; i++)
+        TimerManager_Tick(&manager);
+    
+    Benchmark_Check("TimerManager finish order", numOrdered == 4 && order[0] == 1 &&
+        order[1] == 3 && order[2] == 0 && order[3] == 2);
+    Benchmark_Check("TimerManager_GetTicksUntilNextExpiry", ticksUntilRight &&
+        TimerManager_GetTicksUntilNextExpiry(&manager) == 0);
+    Benchmark_Check("TimerManager_GetTicksRemaining", remainingRight);
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckCatchUp(void)
+{
+    TimerManager_Init(&manager);
+    
+    // One that calls back and one that nobody looks at
+    Timer_Init(&timers[0], 4);
+    Timer_SetFinishedCallback(&timers[0], RecordOrder);
+    Timer_SetPeriodic(&timers[0], true);
+    TimerManager_StartTimer(&manager, &timers[0]);
+    
+    Timer_Init(&timers[1], 3);
+    Timer_SetFinishedCallback(&timers[1], 0);
+    Timer_SetPeriodic(&timers[1], true);
+    TimerManager_StartTimer(&manager, &timers[1]);
+    
+    // Timer_Init leaves these alone, and the last check finished this timer
+    Timer_ClearFlag(&timers[1]);
+    Timer_GetMissedExpirations(&timers[1]);
+    
+    // Asleep for 10 ticks. The first one should have gone off at 4 and 8, and
+    // the second at 3, 6, and 9.
+    numOrdered = 0;
+    TimerManager_AdvanceTicks(&manager, 10);
+    
+    Benchmark_Check("TimerManager catch up callbacks", numOrdered == 2 &&
+        TimerManager_GetTicksRemaining(&manager, &timers[0]) == 2);
+    Benchmark_Check("TimerManager catch up missed", Timer_IsFinished(&timers[1]) &&
+        Timer_GetMissedExpirations(&timers[1]) == 2 &&
+        TimerManager_GetTicksUntilNextExpiry(&manager) == 2);
+    
+    TimerManager_StopTimer(&manager, &timers[0]);
+    TimerManager_StopTimer(&manager, &timers[1]);
+    Timer_SetPeriodic(&timers[0], false);
+    Timer_SetPeriodic(&timers[1], false);
+}
+
+// -----------------------------------------------------------------------------
+
+static void CheckTicksClamp(void)
+{
+    uint32_t longTicks = TIMEBASE_SECONDS_TO_TICKS(100);
+    
+    // 100 seconds doesn't fit in 16 bits with a 1 ms tick
+    if(TIMER_COUNT_SIZE == 32 || longTicks <= 0xFFFFUL)
+        Benchmark_Check("TIMER_TICKS", TIMER_TICKS(longTicks) == longTicks);
+    else
+        Benchmark_Check("TIMER_TICKS", TIMER_TICKS(longTicks) == TIMER_MAX_COUNT);
+    
+    Benchmark_Check("TIMER_TICKS short", TIMER_TICKS(TIMEBASE_MS_TO_TICKS(500)) == TIMEBASE_MS_TO_TICKS(500));
+}
+
+// -----------------------------------------------------------------------------
+
+static uint32_t ExpectedExpirations(uint16_t numTimers)
+{
+    uint32_t total = 0;
+    uint16_t i;
+    
+    for(i = 0; i < numTimers; i++)
+        total += TOTAL_TICKS / Timer_GetPeriod(&timers[i]);
+    
+    return total;
+}
+
+// -----------------------------------------------------------------------------
+
+static void RunTicks(uint16_t numTimers)
+{
+    char name[48];
+    uint32_t tick;
+    uint32_t tickExpirations;
+    uint16_t i;
+    uint64_t start;
+    
+    // Spread the periods out like a real program would
+    for(i = 0; i < numTimers; i++)
+    {
+        Timer_Init(&timers[i], 10 + (i * 37) % 1000);
+        Timer_SetFinishedCallback(&timers[i], RestartTimer);
+        Timer_Start(&timers[i]);
+    }
+    
+    expirations = 0;
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+    {
+        for(i = 0; i < numTimers; i++)
+            Timer_Tick(&timers[i]);
+    }
+    
+    sprintf(name, "Timer_Tick x %u timers", numTimers);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    benchmarkSink += expirations;
+    tickExpirations = expirations;
+    
+    TimerManager_Init(&manager);
+    
+    for(i = 0; i < numTimers; i++)
+    {
+        Timer_SetFinishedCallback(&timers[i], RestartManagedTimer);
+        TimerManager_StartTimer(&manager, &timers[i]);
+    }
+    
+    expirations = 0;
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+        TimerManager_Tick(&manager);
+    
+    sprintf(name, "TimerManager_Tick, %u timers", numTimers);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    benchmarkSink += expirations;
+    
+    sprintf(name, "Timer expirations, %u timers", numTimers);
+    Benchmark_Check(name, tickExpirations == ExpectedExpirations(numTimers) && 
+        expirations == tickExpirations);
+}
+
+// -----------------------------------------------------------------------------
+
+static void RunPeriodicTicks(uint16_t numTimers)
+{
+    char name[48];
+    uint32_t tick;
+    uint32_t tickExpirations;
+    uint16_t i;
+    uint64_t start;
+    
+    for(i = 0; i < numTimers; i++)
+    {
+        Timer_Init(&timers[i], 10 + (i * 37) % 1000);
+        Timer_SetFinishedCallback(&timers[i], CountExpiration);
+        Timer_SetPeriodic(&timers[i], true);
+        Timer_Start(&timers[i]);
+    }
+    
+    expirations = 0;
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+    {
+        for(i = 0; i < numTimers; i++)
+            Timer_Tick(&timers[i]);
+    }
+    
+    sprintf(name, "Timer_Tick x %u periodic timers", numTimers);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    benchmarkSink += expirations;
+    tickExpirations = expirations;
+    
+    TimerManager_Init(&manager);
+    
+    for(i = 0; i < numTimers; i++)
+        TimerManager_StartTimer(&manager, &timers[i]);
+    
+    expirations = 0;
+    start = Benchmark_GetTimeNs();
+    
+    for(tick = 0; tick < TOTAL_TICKS; tick++)
+        TimerManager_Tick(&manager);
+    
+    sprintf(name, "TimerManager_Tick, %u periodic timers", numTimers);
+    Benchmark_Report(name, TOTAL_TICKS, 0, Benchmark_GetTimeNs() - start);
+    benchmarkSink += expirations;
+    
+    sprintf(name, "Timer expirations, %u periodic timers", numTimers);
+    Benchmark_Check(name, tickExpirations == ExpectedExpirations(numTimers) && 
+        expirations == tickExpirations);
+    
+    for(i = 0; i < numTimers; i++)
+    {
+        TimerManager_StopTimer(&manager, &timers[i]);
+        Timer_SetPeriodic(&timers[i], false);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+static void CountExpiration(Timer *timer)
+{
+    (void)timer;
+    expirations++;
+}
+
+// -----------------------------------------------------------------------------
+
+static void RecordOrder(Timer *timer)
+{
+    if(numOrdered < sizeof(order))
+        order[numOrdered++] = (uint8_t)(timer - timers);
+}
+
+// -----------------------------------------------------------------------------
+
+static void RestartTimer(Timer *timer)
+{
+    expirations++;
+    Timer_Start(timer);
+}
+
+// -----------------------------------------------------------------------------
+
+static void RestartManagedTimer(Timer *timer)
+{
+    expirations++;
+    TimerManager_StartTimer(&manager, timer);
+}
+
+/*
+ End of File
+ */
@@ -0,0 +1,132 @@
+/* *****************************************************************************
+ * @Summary Trace Benchmarks
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File TraceBenchmark.c
+ * 
+ * @Description
+ *      The same two number debug message, sent both ways. Once formatted 
+ *      with snprintf and written to a transmit buffer, and once as a binary 
+ *      trace record that gets flushed to the same buffer. The transmit buffer
+ *      is emptied right away, like a really fast UART. An operation is one 
+ *      message. The trace is timed in two parts, since only Trace_Event2 
+ *      runs in the code that is being traced.
+ * 
+*******************************************************************************/
+
+#include <stdio.h>
+#include "Benchmark.h"
+#include "Buffer.h"
+#include "Trace.h"
+#include "COBS.h"
+
+// ***** Defines ***************************************************************
+
+#define TX_SIZE         255
+#define TRACE_SIZE      256
+#define TOTAL_MESSAGES  (4u * 1024u * 1024u)
+
+// Flush like a main loop would, every few messages
+#define FLUSH_INTERVAL  8
+
+// ***** Function Prototypes ***************************************************
+
+static void Formatted(void);
+static void Traced(void);
+
+// ***** Global Variables ******************************************************
+
+static uint8_t txArray[TX_SIZE];
+static uint8_t traceArray[TRACE_SIZE];
+static Buffer txBuffer;
+
+// *****************************************************************************
+
+void TraceBenchmark_Run(void)
+{
+    Formatted();
+    Traced();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void Formatted(void)
+{
+    char line[48];
+    uint32_t i;
+    uint32_t sent = 0;
+    int length;
+    uint64_t start;
+    
+    Buffer_Init(&txBuffer, txArray, TX_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_MESSAGES; i++)
+    {
+        length = snprintf(line, sizeof(line), "Button %u event %u\n", (unsigned)(i & 7), (unsigned)(i & 3));
+        Buffer_Write(&txBuffer, (const uint8_t *)line, (BufferIndex)length);
+        sent += Buffer_GetCount(&txBuffer);
+        Buffer_CommitRead(&txBuffer, Buffer_GetCount(&txBuffer));
+    }
+    
+    Benchmark_Report("snprintf to the transmit buffer", TOTAL_MESSAGES, sent, Benchmark_GetTimeNs() - start);
+    benchmarkSink += sent;
+}
+
+// -----------------------------------------------------------------------------
+
+static void Traced(void)
+{
+    uint32_t i;
+    uint32_t sent = 0;
+    uint64_t start;
+    uint64_t flushStart;
+    uint64_t flushTime = 0;
+    uint32_t flushed = 0;
+    COBSDecoder decoder;
+    uint8_t record[TRACE_MAX_RECORD];
+    
+    Buffer_Init(&txBuffer, txArray, TX_SIZE);
+    Trace_Init(traceArray, TRACE_SIZE);
+    start = Benchmark_GetTimeNs();
+    
+    for(i = 0; i < TOTAL_MESSAGES; i++)
+    {
+        Trace_Event2(TRACE_BUTTON_EVENT, i & 7, i & 3);
+        
+        if(i % FLUSH_INTERVAL == FLUSH_INTERVAL - 1)
+        {
+            flushStart = Benchmark_GetTimeNs();
+            flushed += Trace_Flush(&txBuffer);
+            sent += Buffer_GetCount(&txBuffer);
+            Buffer_CommitRead(&txBuffer, Buffer_GetCount(&txBuffer));
+            flushTime += Benchmark_GetTimeNs() - flushStart;
+        }
+    }
+    
+    // The part that runs in the code being traced, and the part that runs 
+    // in the background later
+    Benchmark_Report("Trace_Event2", TOTAL_MESSAGES, 0, Benchmark_GetTimeNs() - start - flushTime);
+    Benchmark_Report("Trace_Flush, per message", TOTAL_MESSAGES, sent, flushTime);
+    Benchmark_Check("Trace_Flush sent everything", flushed == TOTAL_MESSAGES);
+    benchmarkSink += sent;
+    
+    // Decode one like the host would and make sure it's what went in
+    Trace_Event2(TRACE_BUTTON_EVENT, 0x12345678, 3);
+    Trace_Flush(&txBuffer);
+    COBS_InitDecoder(&decoder, record, sizeof(record));
+    Benchmark_Check("Trace record", COBS_Decode(&decoder, &txBuffer) == TRACE_HEADER_SIZE + 8 &&
+        record[0] == TRACE_BUTTON_EVENT && record[TRACE_HEADER_SIZE] == 0x78 && 
+        record[TRACE_HEADER_SIZE + 3] == 0x12 && record[TRACE_HEADER_SIZE + 4] == 3);
+}
+
+/*
+ End of File
+ */
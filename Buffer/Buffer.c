@@ -10,11 +10,24 @@
  * @Description
  *      A basic 8-bit ring buffer. To create a buffer, the minimum you will 
  *      need is a buffer object, an array pointer, and the size of the array.
+ *      The size of the indexes is set by BUFFER_INDEX_SIZE in Buffer.h
  * 
  * ****************************************************************************/
 
+#include <string.h>
 #include "Buffer.h"
 
+#ifdef PROFILE_ENABLE
+#include "Profile.h"
+#else
+#define PROFILE_BEGIN(point)
+#define PROFILE_END(point)
+#endif
+
+#ifdef BUFFER_ENABLE_CRC
+#include "CRC.h"
+#endif
+
 // ***** Defines ***************************************************************
 
 /*  I'm going to use a simple check to go around the ring buffer. In the past, 
@@ -22,13 +35,75 @@
     but it restricted the buffer size to powers of two only. */
 #define CircularIncrement(i, size) i == (size - 1) ? 0 : i + 1
 
+/*  If you define BUFFER_POWER_OF_TWO, you get the old way back. Every buffer 
+    must then be a power of two in size. The head and tail are allowed to run 
+    freely and get masked whenever they are used to access the array. The 
+    count is simply the head minus the tail, so there are no compares at all. 
+    This also means every spot in the array can be used. Otherwise, one spot
+    has to stay empty so that we can tell a full buffer from an empty one. */
+#ifdef BUFFER_POWER_OF_TWO
+    #define Wrap(self, i)                   ((i) & ((self)->private.size - 1))
+    #define NextIndex(self, i)              ((i) + 1)
+    #define AdvanceIndex(self, i, n)        ((i) + (n))
+    #define Capacity(self)                  ((self)->private.size)
+    #define CountFromIndex(self, h, t)      ((BufferIndex)((h) - (t)))
+    #define HasSpace(self, h, nextH, t)     (CountFromIndex(self, h, t) != Capacity(self))
+#else
+    #define Wrap(self, i)                   (i)
+    #define NextIndex(self, i)              (CircularIncrement(i, (self)->private.size))
+    #define AdvanceIndex(self, i, n)        ((n) >= (self)->private.size - (i) ? (n) - ((self)->private.size - (i)) : (i) + (n))
+    #define Capacity(self)                  ((self)->private.size - 1)
+    #define CountFromIndex(self, h, t)      ((h) >= (t) ? (h) - (t) : (self)->private.size - (t) + (h))
+    #define HasSpace(self, h, nextH, t)     ((nextH) != (t))
+#endif
+
+/*  The data has to actually be in the array before the head is moved, and it 
+    has to be read out before the tail is moved. Otherwise an interrupt could
+    see the new index before the data is ready. The volatile head and tail 
+    keep the compiler in line on small micros. On anything with a write buffer 
+    or a cache, define this as your memory barrier instruction, like __DMB(). */
+#ifndef BUFFER_MEMORY_BARRIER
+    #if defined(__GNUC__)
+        #define BUFFER_MEMORY_BARRIER()     __asm__ volatile ("" ::: "memory")
+    #else
+        #define BUFFER_MEMORY_BARRIER()
+    #endif
+#endif
+
+/*  The writer owns every counter except bytesRead, so updating them doesn't 
+    break the one writer, one reader rule. Without statistics these go away. */
+#ifdef BUFFER_ENABLE_STATISTICS
+    #define CountStat(self, stat, n)        ((self)->private.statistics.stat += (n))
+    #define UpdateHighWaterMark(self, count) if((count) > (self)->private.statistics.highWaterMark) \
+                                                (self)->private.statistics.highWaterMark = (count)
+#else
+    #define CountStat(self, stat, n)
+    #define UpdateHighWaterMark(self, count)
+#endif
+
+/*  Only the writer changes the running CRC, the same as the head. Without 
+    CRC support these go away. */
+#ifdef BUFFER_ENABLE_CRC
+    #define UpdateWriteCRCChar(self, data)  ((self)->private.writeCrc = CRC16_UpdateChar((self)->private.writeCrc, (data)))
+    #define UpdateWriteCRC(self, i, n)      UpdateWriteCRCSpan(self, i, n)
+#else
+    #define UpdateWriteCRCChar(self, data)
+    #define UpdateWriteCRC(self, i, n)
+#endif
+
 // ***** Function Prototypes ***************************************************
 
+static void CheckHighWatermark(Buffer *self, BufferIndex count);
+static void CheckLowWatermark(Buffer *self, BufferIndex count);
+static void CheckDataAvailable(Buffer *self, BufferIndex head, BufferIndex length);
+static void CheckSpaceAvailable(Buffer *self, BufferIndex tail, BufferIndex length);
+
+#ifdef BUFFER_ENABLE_CRC
+static void UpdateWriteCRCSpan(Buffer *self, BufferIndex head, BufferIndex length);
+#endif
 
 // ***** Global Variables ******************************************************
 
-// local function pointer
-void (*Buffer_OverflowCallback)(void);
 
 /*******************************************************************************
  * Initializes a Buffer object
@@ -44,7 +119,7 @@ void (*Buffer_OverflowCallback)(void);
  * 
  * @return none
  */
-void Buffer_Init(Buffer *self, uint8_t *arrayIn, uint8_t arrayInSize)
+void Buffer_Init(Buffer *self, uint8_t *arrayIn, BufferIndex arrayInSize)
 {
     Buffer_InitWithOverwrite(self, arrayIn, arrayInSize, false);
 }
@@ -73,12 +148,35 @@ void Buffer_Init(Buffer *self, uint8_t *arrayIn, uint8_t arrayInSize)
  * 
  * @return none
  */
-void Buffer_InitWithOverwrite(Buffer *self, uint8_t *arrayIn, uint8_t arrayInSize, bool overwrite)
+void Buffer_InitWithOverwrite(Buffer *self, uint8_t *arrayIn, BufferIndex arrayInSize, bool overwrite)
 {
+#ifdef BUFFER_POWER_OF_TWO
+    // If you didn't give me a power of two, only use as much of the array as 
+    // I can. Clear the lowest bit until there is only one left.
+    while(arrayInSize & (arrayInSize - 1))
+        arrayInSize &= arrayInSize - 1;
+#endif
     self->private.buffer = arrayIn;
     self->private.size = arrayInSize;
+    self->private.head = 0;
+    self->private.tail = 0;
+    self->private.overflowCallbackFunc = 0;
+    self->private.highWatermark = 0;
+    self->private.lowWatermark = 0;
+    self->private.highWatermarkCallbackFunc = 0;
+    self->private.lowWatermarkCallbackFunc = 0;
+    self->private.watermarkRaised = 0;
+    self->private.watermarkCleared = 0;
+    self->private.dataAvailableCallbackFunc = 0;
+    self->private.spaceAvailableCallbackFunc = 0;
     self->enableOverwrite = overwrite;
-    self->count = 0;
+    self->overflow = false;
+#ifdef BUFFER_ENABLE_STATISTICS
+    Buffer_ResetStatistics(self);
+#endif
+#ifdef BUFFER_ENABLE_CRC
+    Buffer_ResetWriteCRC(self);
+#endif
 }
 
 /*******************************************************************************
@@ -92,39 +190,58 @@ void Buffer_InitWithOverwrite(Buffer *self, uint8_t *arrayIn, uint8_t arrayInSiz
  */
 void Buffer_WriteChar(Buffer *self, uint8_t receivedChar)
 {
-    uint8_t tempHead = CircularIncrement(self->private.head, self->private.size);
+    BufferIndex head = self->private.head;
+    BufferIndex tempHead = NextIndex(self, head);
+    BufferIndex count;
+    PROFILE_BEGIN(PROFILE_BUFFER_WRITE_CHAR);
     
-    if(tempHead != self->private.tail)
+    if(HasSpace(self, head, tempHead, self->private.tail))
     {
         // There is space in the buffer
-        self->private.buffer[self->private.head] = receivedChar;
+        self->private.buffer[Wrap(self, head)] = receivedChar;
+        BUFFER_MEMORY_BARRIER();
         self->private.head = tempHead;
-        self->count++;
+        count = CountFromIndex(self, tempHead, self->private.tail);
+        UpdateWriteCRCChar(self, receivedChar);
+        CountStat(self, bytesWritten, 1);
+        UpdateHighWaterMark(self, count);
+        CheckHighWatermark(self, count);
+        CheckDataAvailable(self, tempHead, 1);
     }
     else if(self->enableOverwrite)
     {
         // There is no space in the buffer and overwrite is enabled
-        self->private.buffer[self->private.head] = receivedChar;
+        self->private.buffer[Wrap(self, head)] = receivedChar;
         self->private.head = tempHead; // Mark the next space to be overwritten
-        CircularIncrement(self->private.tail, self->private.size); // Move the tail up one
+        self->private.tail = NextIndex(self, self->private.tail); // Move the tail up one
         self->overflow = true;
+        UpdateWriteCRCChar(self, receivedChar);
+        CountStat(self, bytesWritten, 1);
+        CountStat(self, bytesOverwritten, 1);
+        UpdateHighWaterMark(self, Capacity(self));
+        CheckHighWatermark(self, Capacity(self));
     }
     else
     {
         // There is no space in the buffer and overwrite is disabled
+#ifndef BUFFER_POWER_OF_TWO
         if(self->overflow == false)
         {
-            // We are about to overflow. Go ahead and store the last char
-            self->private.buffer[self->private.head] = receivedChar;
+            // We are about to overflow. Go ahead and store the last char in 
+            // the empty spot. (A power of two buffer doesn't have one)
+            self->private.buffer[head] = receivedChar;
         }
+#endif
         
         self->overflow = true; // Notify of overflow
+        CountStat(self, bytesDropped, 1);
         
-        if(Buffer_OverflowCallback)
+        if(self->private.overflowCallbackFunc)
         {
-            Buffer_OverflowCallback;
+            self->private.overflowCallbackFunc(self);
         }
     }
+    PROFILE_END(PROFILE_BUFFER_WRITE_CHAR);
 }
 
 /*******************************************************************************
@@ -141,18 +258,313 @@ void Buffer_WriteChar(Buffer *self, uint8_t receivedChar)
 uint8_t Buffer_ReadChar(Buffer *self)
 {
     uint8_t dataToReturn = 0;
+    BufferIndex tail = self->private.tail;
+    PROFILE_BEGIN(PROFILE_BUFFER_READ_CHAR);
     
-    if(self->private.head != self->private.tail)
+    if(self->private.head != tail)
     {
         // The buffer is not empty
-        dataToReturn =  self->private.buffer[self->private.tail];
-        CircularIncrement(self->private.tail, self->private.size);
-        self->count--;
+        dataToReturn =  self->private.buffer[Wrap(self, tail)];
+        BUFFER_MEMORY_BARRIER();
+        tail = NextIndex(self, tail);
+        self->private.tail = tail;
         self->overflow = false;
+        CountStat(self, bytesRead, 1);
+        CheckLowWatermark(self, CountFromIndex(self, self->private.head, tail));
+        CheckSpaceAvailable(self, tail, 1);
     }
+    PROFILE_END(PROFILE_BUFFER_READ_CHAR);
     return dataToReturn;
 }
 
+/*******************************************************************************
+ * Puts a block of data into the buffer. Updates the head.
+ * <p>
+ * The data is copied in at most two pieces: one up to the end of the array 
+ * and one from the start of the array after it wraps around. This is much 
+ * faster than calling Buffer_WriteChar once for every byte.
+ * <p>
+ * If there isn't enough space and overwrite is disabled, only the bytes that 
+ * fit are written and the overflow flag is set. If overwrite is enabled, the 
+ * oldest data is thrown away to make room for the new data.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param data  pointer to the data to store in the buffer
+ * 
+ * @param length  the number of bytes to store
+ * 
+ * @return the number of bytes that were stored
+ */
+BufferIndex Buffer_Write(Buffer *self, const uint8_t *data, BufferIndex length)
+{
+    BufferIndex capacity = Capacity(self);
+    BufferIndex space = capacity - Buffer_GetCount(self);
+    BufferIndex firstPiece;
+    
+    if(length > space)
+    {
+        if(self->enableOverwrite)
+        {
+            if(length > capacity)
+            {
+                // Only the newest data will fit
+                CountStat(self, bytesDropped, length - capacity);
+                data += length - capacity;
+                length = capacity;
+            }
+            
+            // Move the tail up to make room. Don't use Buffer_CommitRead. 
+            // Nobody actually read this data.
+            self->private.tail = AdvanceIndex(self, self->private.tail, length - space);
+            CountStat(self, bytesOverwritten, length - space);
+        }
+        else
+        {
+            CountStat(self, bytesDropped, length - space);
+            length = space;
+            
+            if(self->private.overflowCallbackFunc)
+            {
+                self->private.overflowCallbackFunc(self);
+            }
+        }
+        self->overflow = true;
+    }
+    
+    firstPiece = self->private.size - Wrap(self, self->private.head);
+    
+    if(firstPiece > length)
+        firstPiece = length;
+    
+    memcpy(&self->private.buffer[Wrap(self, self->private.head)], data, firstPiece);
+    memcpy(self->private.buffer, data + firstPiece, length - firstPiece);
+    
+    Buffer_CommitWrite(self, length);
+    
+    return length;
+}
+
+/*******************************************************************************
+ * Reads a block of data from the buffer. Updates the tail.
+ * <p>
+ * Like Buffer_Write, the data is copied out in at most two pieces. If there
+ * is less data in the buffer than you asked for, you only get what is there.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param data  pointer to an array to copy the data into
+ * 
+ * @param length  the maximum number of bytes to read
+ * 
+ * @return the number of bytes that were read
+ */
+BufferIndex Buffer_Read(Buffer *self, uint8_t *data, BufferIndex length)
+{
+    BufferIndex count = Buffer_GetCount(self);
+    BufferIndex firstPiece;
+    
+    if(length > count)
+        length = count;
+    
+    firstPiece = self->private.size - Wrap(self, self->private.tail);
+    
+    if(firstPiece > length)
+        firstPiece = length;
+    
+    memcpy(data, &self->private.buffer[Wrap(self, self->private.tail)], firstPiece);
+    memcpy(data + firstPiece, self->private.buffer, length - firstPiece);
+    
+    Buffer_CommitRead(self, length);
+    
+    return length;
+}
+
+/*******************************************************************************
+ * Gives you direct access to the data stored in the buffer
+ * <p>
+ * Gives you a pointer to the oldest data in the buffer and tells you how many
+ * bytes you can read from that pointer before the buffer wraps around. This 
+ * lets you parse the data in place without copying it. If the data wraps 
+ * around the end of the array, call this again after Buffer_CommitRead to get 
+ * the rest of it.
+ * <p>
+ * Nothing is removed from the buffer until you call Buffer_CommitRead.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param data  set to point to the stored data
+ * 
+ * @return the number of bytes that are available at the pointer
+ */
+BufferIndex Buffer_PeekContiguous(Buffer *self, uint8_t **data)
+{
+    BufferIndex count = Buffer_GetCount(self);
+    BufferIndex tail = self->private.tail;
+    BufferIndex length = self->private.size - Wrap(self, tail);
+    
+    if(length > count)
+        length = count; // all of the data is in one piece
+    
+    *data = &self->private.buffer[Wrap(self, tail)];
+    return length;
+}
+
+/*******************************************************************************
+ * Removes data from the buffer without copying it. Updates the tail.
+ * <p>
+ * Use this after you are done with the data from Buffer_PeekContiguous. You 
+ * can also use it to throw away data you don't want.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param length  the number of bytes to remove
+ * 
+ * @return none
+ */
+void Buffer_CommitRead(Buffer *self, BufferIndex length)
+{
+    BufferIndex count = Buffer_GetCount(self);
+    BufferIndex tail = self->private.tail;
+    
+    if(length > count)
+        length = count;
+    
+    if(length == 0)
+        return;
+    
+    tail = AdvanceIndex(self, tail, length);
+    
+    BUFFER_MEMORY_BARRIER();
+    self->private.tail = tail;
+    self->overflow = false;
+    CountStat(self, bytesRead, length);
+    CheckLowWatermark(self, CountFromIndex(self, self->private.head, tail));
+    CheckSpaceAvailable(self, tail, length);
+}
+
+/*******************************************************************************
+ * Gives you direct access to the free space in the buffer
+ * <p>
+ * Gives you a pointer to the next free space in the buffer and tells you how
+ * many bytes you can write to that pointer before the buffer wraps around. 
+ * This lets you fill the buffer in place without copying. Once you are done, 
+ * call Buffer_CommitWrite with the number of bytes you actually wrote.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param data  set to point to the free space
+ * 
+ * @return the number of bytes that can be written at the pointer
+ */
+BufferIndex Buffer_ReserveContiguous(Buffer *self, uint8_t **data)
+{
+    BufferIndex space = Capacity(self) - Buffer_GetCount(self);
+    BufferIndex head = self->private.head;
+    BufferIndex length = self->private.size - Wrap(self, head);
+    
+    if(length > space)
+        length = space;
+    
+    *data = &self->private.buffer[Wrap(self, head)];
+    return length;
+}
+
+/*******************************************************************************
+ * Adds data that was written in place to the buffer. Updates the head.
+ * <p>
+ * Use this after you've filled the space from Buffer_ReserveContiguous. 
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param length  the number of bytes that were written
+ * 
+ * @return none
+ */
+void Buffer_CommitWrite(Buffer *self, BufferIndex length)
+{
+    BufferIndex space = Capacity(self) - Buffer_GetCount(self);
+    BufferIndex head = self->private.head;
+    
+    if(length > space)
+        length = space;
+    
+    UpdateWriteCRC(self, head, length);
+    head = AdvanceIndex(self, head, length);
+    
+    BUFFER_MEMORY_BARRIER();
+    self->private.head = head;
+    CountStat(self, bytesWritten, length);
+    UpdateHighWaterMark(self, Capacity(self) - space + length);
+    CheckHighWatermark(self, Capacity(self) - space + length);
+    
+    if(length != 0)
+        CheckDataAvailable(self, head, length);
+}
+
+/*******************************************************************************
+ * Looks for a byte in the data stored in the buffer
+ * <p>
+ * Nothing is removed from the buffer. The stored data is searched in place 
+ * with memchr, in at most two pieces, which is a lot faster than reading it
+ * out one byte at a time. 
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param value  the byte to look for
+ * 
+ * @return how many bytes from the oldest byte the value is, or 
+ *         BUFFER_NOT_FOUND if it isn't in the buffer
+ */
+BufferIndex Buffer_FindByte(Buffer *self, uint8_t value)
+{
+    BufferIndex count = Buffer_GetCount(self);
+    uint8_t *start = &self->private.buffer[Wrap(self, self->private.tail)];
+    BufferIndex firstPiece = self->private.size - Wrap(self, self->private.tail);
+    const uint8_t *found;
+    
+    if(firstPiece > count)
+        firstPiece = count;
+    
+    found = (const uint8_t *)memchr(start, value, firstPiece);
+    
+    if(found)
+        return (BufferIndex)(found - start);
+    
+    // Not in the first piece. Try the part that wrapped around.
+    found = (const uint8_t *)memchr(self->private.buffer, value, count - firstPiece);
+    
+    if(found)
+        return firstPiece + (BufferIndex)(found - self->private.buffer);
+    
+    return BUFFER_NOT_FOUND;
+}
+
+/*******************************************************************************
+ * Tells you if there is a whole frame waiting in the buffer
+ * <p>
+ * A frame is everything up to and including the delimiter. If you get back 
+ * something other than zero, you can pass it straight to Buffer_Read to get 
+ * the whole frame, or parse it in place with Buffer_PeekContiguous and drop 
+ * it with Buffer_CommitRead.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param delimiter  the byte at the end of every frame
+ * 
+ * @return the length of the next frame including the delimiter, or zero if 
+ *         there isn't a complete frame yet
+ */
+BufferIndex Buffer_FrameAvailable(Buffer *self, uint8_t delimiter)
+{
+    BufferIndex offset = Buffer_FindByte(self, delimiter);
+    
+    if(offset == BUFFER_NOT_FOUND)
+        return 0;
+    else
+        return offset + 1;
+}
+
 /*******************************************************************************
  * Gets the amount of data stored in the buffer
  * 
@@ -160,15 +572,30 @@ uint8_t Buffer_ReadChar(Buffer *self)
  *
  * @return number of bytes in the buffer
  */
-uint8_t Buffer_GetCount(Buffer *self)
+BufferIndex Buffer_GetCount(Buffer *self)
 {
-/*  For now, I'm using a simple counter. If I choose to limit by buffer
-    to powers of two, then I can do away with the counter and get the size 
-    based on the head and tail with modulo division. Example below
-    return (uint8_t)(self->private.size + self->private.head - self->private.tail) & (self->private.size - 1); 
-    */
+/*  There is no counter anymore. If both the interrupt and the main loop 
+    update the same counter, one of them can lose an update. Instead, the 
+    count is worked out from the head and the tail. Each index only ever gets 
+    written by one side, so this is safe to call from either side. */
+    BufferIndex head = self->private.head;
+    BufferIndex tail = self->private.tail;
+    
+    return CountFromIndex(self, head, tail);
+}
 
-    return self->count;
+/*******************************************************************************
+ * Gets the amount of free space left in the buffer
+ * <p>
+ * Useful if you want to know if a whole message will fit before you write it
+ * 
+ * @param self  pointer to the Buffer that you are using
+ *
+ * @return number of bytes that can still be written
+ */
+BufferIndex Buffer_GetSpace(Buffer *self)
+{
+    return Capacity(self) - Buffer_GetCount(self);
 }
 
 /*******************************************************************************
@@ -180,9 +607,7 @@ uint8_t Buffer_GetCount(Buffer *self)
  */
 bool Buffer_IsFull(Buffer *self)
 {
-    uint8_t tempHead = CircularIncrement(self->private.head, self->private.size);
-    
-    if(tempHead == self->private.tail)
+    if(Buffer_GetCount(self) == Capacity(self))
         return true;
     else
         return false;
@@ -199,7 +624,7 @@ bool Buffer_IsFull(Buffer *self)
  */
 bool Buffer_IsNotEmpty(Buffer *self)
 {
-    if(self->count != 0)
+    if(self->private.head != self->private.tail)
         return true;
     else
         return false;
@@ -228,14 +653,351 @@ bool Buffer_DidOverflow(Buffer *self)
  * 
  * Only works if you have overwrite disabled. If you set this function pointer, 
  * your function will automatically be called whenever the buffer tries to 
- * overwrite data. The overflow boolean is also set.
+ * overwrite data. The overflow boolean is also set. Each buffer has its own
+ * callback. It is called right from the write, so from inside the interrupt 
+ * if that's where you are writing from. Keep it short.
+ * 
+ * @param self  pointer to the Buffer type that you are using
+ * 
+ * @param Function  format: void SomeFunction(Buffer *bufferContext)
+ */
+void Buffer_SetOverflowCallback(Buffer *self, BufferCallbackFunc Function)
+{
+    self->private.overflowCallbackFunc = Function;
+}
+
+/*******************************************************************************
+ * Sets the levels where the watermark callbacks happen
+ * <p>
+ * When the number of bytes in the buffer goes up to the high watermark, the 
+ * high watermark callback is called and the buffer is throttled. It stays 
+ * throttled until the reader brings the count back down to the low watermark.
+ * Then the low watermark callback is called. This is what you would use to 
+ * drive a flow control line, so that the other end stops sending before the 
+ * buffer actually fills up. Leave enough room above the high watermark for
+ * whatever the other end sends before it notices.
+ * <p>
+ * The high callback is called from the writer, and the low callback is 
+ * called from the reader. If the reader gets interrupted right as it crosses
+ * the low watermark, the writer may fill back up past the high watermark 
+ * before the low callback happens. If so, the high callback happens again on 
+ * the very next write.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param high  the count where the buffer is throttled. Zero turns off the
+ *              watermarks.
+ * 
+ * @param low  the count where the buffer is no longer throttled. Must be 
+ *             lower than the high watermark.
+ * 
+ * @return none
+ */
+void Buffer_SetWatermarks(Buffer *self, BufferIndex high, BufferIndex low)
+{
+    if(high > Capacity(self))
+        high = Capacity(self);
+    
+    if(low >= high && high != 0)
+        low = high - 1;
+    
+    self->private.highWatermark = high;
+    self->private.lowWatermark = low;
+}
+
+/*******************************************************************************
+ * A function pointer that is called when the buffer reaches its high 
+ * watermark.
+ * 
+ * @param self  pointer to the Buffer type that you are using
+ * 
+ * @param Function  format: void SomeFunction(Buffer *bufferContext)
+ */
+void Buffer_SetHighWatermarkCallback(Buffer *self, BufferCallbackFunc Function)
+{
+    self->private.highWatermarkCallbackFunc = Function;
+}
+
+/*******************************************************************************
+ * A function pointer that is called when the buffer gets back down to its low
+ * watermark after reaching the high watermark.
+ * 
+ * @param self  pointer to the Buffer type that you are using
+ * 
+ * @param Function  format: void SomeFunction(Buffer *bufferContext)
+ */
+void Buffer_SetLowWatermarkCallback(Buffer *self, BufferCallbackFunc Function)
+{
+    self->private.lowWatermarkCallbackFunc = Function;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if the buffer is throttled
+ * <p>
+ * The buffer is throttled from the time it reaches the high watermark until 
+ * it gets back down to the low watermark.
+ * 
+ * @param self  pointer to the Buffer type that you are using
+ * 
+ * @return true if buffer is throttled
+ */
+bool Buffer_IsThrottled(Buffer *self)
+{
+    if(self->private.watermarkRaised != self->private.watermarkCleared)
+        return true;
+    else
+        return false;
+}
+
+/*******************************************************************************
+ * A function pointer that is called when data shows up in an empty buffer
+ * <p>
+ * This is called from the writer, so from inside the interrupt if that's 
+ * where you are writing from. Use it to wake up whatever reads the buffer, 
+ * like a Scheduler task, instead of checking Buffer_IsNotEmpty over and over.
+ * It only happens when the buffer was empty, so the reader has to keep 
+ * reading until the buffer is empty again or it won't hear about the data 
+ * that's left. It can occasionally happen when the buffer wasn't quite empty,
+ * if the reader was in the middle of reading. Checking again doesn't hurt.
+ * 
+ * @param self  pointer to the Buffer type that you are using
+ * 
+ * @param Function  format: void SomeFunction(Buffer *bufferContext)
+ */
+void Buffer_SetDataAvailableCallback(Buffer *self, BufferCallbackFunc Function)
+{
+    self->private.dataAvailableCallbackFunc = Function;
+}
+
+/*******************************************************************************
+ * A function pointer that is called when space opens up in a full buffer
+ * <p>
+ * This is called from the reader. Use it to wake up whatever is waiting to 
+ * write more, like a task that is sending out a transmit buffer. Just like 
+ * the data available callback, the writer should keep writing until the 
+ * buffer is full again or it has nothing left to send.
  * 
  * @param self  pointer to the Buffer type that you are using
  * 
- * @param Function  format: void SomeFunction(void)
+ * @param Function  format: void SomeFunction(Buffer *bufferContext)
  */
-void Buffer_SetOverflowCallback(void (*Function)(void))
+void Buffer_SetSpaceAvailableCallback(Buffer *self, BufferCallbackFunc Function)
 {
-    Buffer_OverflowCallback = Function;
+    self->private.spaceAvailableCallbackFunc = Function;
 }
 
+#ifdef BUFFER_ENABLE_STATISTICS
+/*******************************************************************************
+ * Copies out the counters for this buffer
+ * <p>
+ * Compare the high water mark with the size of your array. If it never gets 
+ * close, your array is bigger than it needs to be. If anything was dropped or
+ * overwritten, it is too small, or the reader isn't keeping up.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param statistics  pointer to where the counters should be copied to
+ * 
+ * @return none
+ */
+void Buffer_GetStatistics(Buffer *self, BufferStatistics *statistics)
+{
+    *statistics = self->private.statistics;
+}
+
+/*******************************************************************************
+ * Sets all of the counters for this buffer back to zero
+ * <p>
+ * The counters are changed by both the writer and the reader. If one of them 
+ * is an interrupt, disable it while you do this or a count could get lost.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @return none
+ */
+void Buffer_ResetStatistics(Buffer *self)
+{
+    memset(&self->private.statistics, 0, sizeof(BufferStatistics));
+}
+#endif
+
+#ifdef BUFFER_ENABLE_CRC
+/*******************************************************************************
+ * Works out the CRC16 of the data stored in the buffer
+ * <p>
+ * Nothing is removed from the buffer. The CRC is done in place, in at most 
+ * two pieces, starting from the oldest byte. Use it with 
+ * Buffer_FrameAvailable to check a whole frame before you read it, or throw 
+ * it away with Buffer_CommitRead if it's bad.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param length  the number of bytes to include
+ * 
+ * @param crc  CRC16_INITIAL, or the CRC of whatever came before this
+ * 
+ * @return the new CRC
+ */
+uint16_t Buffer_CRC16(Buffer *self, BufferIndex length, uint16_t crc)
+{
+    BufferIndex count = Buffer_GetCount(self);
+    BufferIndex tail = Wrap(self, self->private.tail);
+    BufferIndex firstPiece = self->private.size - tail;
+    
+    if(length > count)
+        length = count;
+    
+    if(firstPiece > length)
+        firstPiece = length;
+    
+    crc = CRC16_Update(crc, &self->private.buffer[tail], firstPiece);
+    return CRC16_Update(crc, self->private.buffer, length - firstPiece);
+}
+
+/*******************************************************************************
+ * Works out the CRC32 of the data stored in the buffer
+ * <p>
+ * The same as Buffer_CRC16. Remember to use CRC32_FINAL on the result once 
+ * you have everything.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @param length  the number of bytes to include
+ * 
+ * @param crc  CRC32_INITIAL, or the CRC of whatever came before this
+ * 
+ * @return the new CRC
+ */
+uint32_t Buffer_CRC32(Buffer *self, BufferIndex length, uint32_t crc)
+{
+    BufferIndex count = Buffer_GetCount(self);
+    BufferIndex tail = Wrap(self, self->private.tail);
+    BufferIndex firstPiece = self->private.size - tail;
+    
+    if(length > count)
+        length = count;
+    
+    if(firstPiece > length)
+        firstPiece = length;
+    
+    crc = CRC32_Update(crc, &self->private.buffer[tail], firstPiece);
+    return CRC32_Update(crc, self->private.buffer, length - firstPiece);
+}
+
+/*******************************************************************************
+ * Gets the CRC16 of everything written to the buffer since the last reset
+ * <p>
+ * Bytes that were dropped because the buffer was full aren't included.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @return the running CRC
+ */
+uint16_t Buffer_GetWriteCRC(Buffer *self)
+{
+    return self->private.writeCrc;
+}
+
+/*******************************************************************************
+ * Starts the running CRC over
+ * <p>
+ * Call this right before you write the first byte of a frame. Only do this 
+ * from the writer's side.
+ * 
+ * @param self  pointer to the Buffer that you are using
+ * 
+ * @return none
+ */
+void Buffer_ResetWriteCRC(Buffer *self)
+{
+    self->private.writeCrc = CRC16_INITIAL;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+/*  The writer and the reader can't share a throttled flag since they could 
+    both change it at the same time. Instead, the writer counts how many times
+    it raised the watermark and the reader counts how many times it cleared 
+    it. When they're different, the buffer is throttled. */
+static void CheckHighWatermark(Buffer *self, BufferIndex count)
+{
+    if(self->private.highWatermark == 0 || count < self->private.highWatermark)
+        return;
+    
+    if(self->private.watermarkRaised != self->private.watermarkCleared)
+        return; // already throttled
+    
+    self->private.watermarkRaised++;
+    
+    if(self->private.highWatermarkCallbackFunc)
+    {
+        self->private.highWatermarkCallbackFunc(self);
+    }
+}
+
+static void CheckLowWatermark(Buffer *self, BufferIndex count)
+{
+    if(count > self->private.lowWatermark)
+        return;
+    
+    if(self->private.watermarkRaised == self->private.watermarkCleared)
+        return; // not throttled
+    
+    self->private.watermarkCleared = self->private.watermarkRaised;
+    
+    if(self->private.lowWatermarkCallbackFunc)
+    {
+        self->private.lowWatermarkCallbackFunc(self);
+    }
+}
+
+/*  The count is checked after the head has moved. If the reader emptied the 
+    buffer before that, it sees no more than what we just wrote. If it hasn't 
+    finished yet, it will see the new data when it checks again. Either way 
+    nothing gets stranded. */
+static void CheckDataAvailable(Buffer *self, BufferIndex head, BufferIndex length)
+{
+    if(!self->private.dataAvailableCallbackFunc)
+        return;
+    
+    if(CountFromIndex(self, head, self->private.tail) <= length)
+    {
+        self->private.dataAvailableCallbackFunc(self);
+    }
+}
+
+static void CheckSpaceAvailable(Buffer *self, BufferIndex tail, BufferIndex length)
+{
+    if(!self->private.spaceAvailableCallbackFunc)
+        return;
+    
+    if(Capacity(self) - CountFromIndex(self, self->private.head, tail) <= length)
+    {
+        self->private.spaceAvailableCallbackFunc(self);
+    }
+}
+
+#ifdef BUFFER_ENABLE_CRC
+/*  The bytes that were just written start at the old head. They can wrap 
+    around the end of the array, the same as Buffer_Write. */
+static void UpdateWriteCRCSpan(Buffer *self, BufferIndex head, BufferIndex length)
+{
+    BufferIndex firstPiece = self->private.size - Wrap(self, head);
+    uint16_t crc = self->private.writeCrc;
+    
+    if(firstPiece > length)
+        firstPiece = length;
+    
+    crc = CRC16_Update(crc, &self->private.buffer[Wrap(self, head)], firstPiece);
+    self->private.writeCrc = CRC16_Update(crc, self->private.buffer, length - firstPiece);
+}
+#endif
+
+/*
+ End of File
+ */
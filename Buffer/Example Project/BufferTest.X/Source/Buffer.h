@@ -1,32 +1,81 @@
 /*******************************************************************************
- * Title: Basic Ring Buffer Header
+ * @Summary Basic Ring Buffer Header
  * 
- * Author: Matthew Spinks
+ * @author Matthew Spinks
  * 
- * File: Buffer.h
+ * Date: Dec. 6, 2019   Original creation
  * 
- * Description:
- *      An interface to be implemented in other c files. This is for a basic
- *      8 bit ring buffer. To create a buffer, the minimum you will need is a 
- *      buffer type, an array pointer, and the size of the array.
+ * @File Buffer.h
  * 
- *      I did it this way to make the buffer easier to interface with. It
- *      lets you control the size of the array so that your not limited to
- *      a fixed size, or to a fixed number of arrays. Also, since I can't use 
- *      malloc with XC-8 anyways.
+ * @Description
+ *      A basic 8-bit ring buffer. To create a buffer, the minimum you will 
+ *      need is a buffer type, an array pointer, and the size of the array.
  * 
- *      For each function, you will pass the buffer that you wish to perform
- *      the operation on.
+ *      This library lets you control the size of your ring buffer as well as 
+ *      the way the buffer handles overflows. Multiple functions are provided 
+ *      to get the status of the buffer. For each function, you will pass the 
+ *      buffer that you wish to perform the operation on.
  * 
  *      There are two initializations: One has a boolean which will allow data 
  *      to be overwritten when placing data in the buffer. The default setting
  *      is false. 
  * 
+ *      Data can be moved in and out one byte at a time, or in blocks. The 
+ *      block functions copy the data in at most two pieces, which is much 
+ *      faster than moving one byte at a time. There are also functions that 
+ *      give you a pointer directly into the buffer so that you can read or 
+ *      fill it in place without making a copy at all.
+ * 
+ *      If your data is split up by a delimiter, like a '\n' or a 0x7E, you 
+ *      can search for it right in the buffer. Once you know where the frame 
+ *      ends, you can pull the whole thing out in one read or parse it in 
+ *      place instead of reading one byte at a time.
+ * 
  *      The buffer will check for overflow before overwriting any data. If 
  *      overflow is about to happen and you have overwrite disabled, you will 
- *      receive a callback function and boolean notification. If you don't 
- *      clear the notification it will be cleared for you when there is space
- *      in the buffer.
+ *      receive a callback function and boolean notification. Every buffer has
+ *      its own callback, and it is given the buffer that overflowed, so your 
+ *      receive and transmit buffers can each handle it their own way. If you
+ *      don't clear the notification it will be cleared for you when there 
+ *      is space in the buffer.
+ * 
+ *      By default, the buffer can be any size up to 255 bytes, and one byte of
+ *      the array is always left empty. For bigger buffers, change the 
+ *      BUFFER_INDEX_SIZE to 16 or 32 bits. If every buffer in your project is a 
+ *      power of two in size, define BUFFER_POWER_OF_TWO for the whole project.
+ *      This makes every operation a lot faster because the indexes can be 
+ *      masked instead of compared, and it allows the whole array to be used. 
+ *      The largest power of two buffer is 128 bytes with 8-bit indexes.
+ * 
+ *      The buffer is safe to share between one writer and one reader, such as 
+ *      a receive interrupt and the main loop, without disabling interrupts. 
+ *      The writer only ever moves the head and the reader only ever moves the 
+ *      tail. There is no shared counter. The only exception is overwrite 
+ *      mode, where the writer has to move the tail to throw away old data. If 
+ *      you use overwrite with an interrupt, you'll have to protect the reader
+ *      yourself.
+ * 
+ *      You can also set a high and a low watermark. When the buffer fills up 
+ *      to the high watermark, you get a callback, and when it drains back down
+ *      to the low watermark, you get another one. Use these to tell the other
+ *      end to stop sending before anything gets lost, like with an RTS line.
+ * 
+ *      Instead of polling, you can also be told when data shows up in an 
+ *      empty buffer, or when space opens up in a full one. These are good for 
+ *      waking up a Scheduler task only when it has something to do.
+ * 
+ *      If you define BUFFER_ENABLE_STATISTICS, every buffer also keeps track 
+ *      of how full it has ever been and how many bytes went through it or got
+ *      lost. Run your project under a real load for a while and then read the 
+ *      numbers back to see how big your buffers actually need to be.
+ * 
+ *      If you define BUFFER_ENABLE_CRC, you can get the CRC of data that is 
+ *      sitting in the buffer without taking it out, so a frame can be checked 
+ *      in place before you read it or throw it away. Every buffer also keeps 
+ *      a running CRC16 of everything written to it since the last reset. For 
+ *      a transmit buffer, that means the CRC of a frame is already done by 
+ *      the time you have written it, and you only have to add it on the end.
+ *      This needs CRC.c from the CRC folder.
  * 
  * ****************************************************************************/
 
@@ -38,139 +87,207 @@
 
 // ***** Defines ***************************************************************
 
+/*  The size of the head, tail, and array size. This limits how big a buffer 
+    can be. Set this to 16 or 32 for your whole project if you need buffers
+    bigger than 255 bytes. Keep in mind that on an 8-bit micro, a 16-bit 
+    index can't be written in one instruction. If the writer and the reader 
+    can interrupt each other, you'll need to protect the reads yourself. */
+#ifndef BUFFER_INDEX_SIZE
+#define BUFFER_INDEX_SIZE   8
+#endif
+
+/*  Buffer_FindByte gives you this when it can't find what you're looking for. 
+    A buffer can never hold this many bytes, so it can't be a real offset. */
+#define BUFFER_NOT_FOUND    ((BufferIndex)~0)
+
+/*  Define BUFFER_ENABLE_STATISTICS for your whole project to turn on the 
+    counters. They cost a few bytes of RAM per buffer and a little bit of 
+    time in every read and write, so they are off by default. */
+
+/*  Define BUFFER_ENABLE_CRC for your whole project to add the CRC functions. 
+    The running write CRC costs a table lookup for every byte written. */
+
 
 // ***** Global Variables ******************************************************
 
+#if BUFFER_INDEX_SIZE == 32
+typedef uint32_t BufferIndex;
+#elif BUFFER_INDEX_SIZE == 16
+typedef uint16_t BufferIndex;
+#else
+typedef uint8_t BufferIndex;
+#endif
+
 typedef struct Buffer Buffer;
 
-/** Buffer Object. You shouldn't have to access anything in here directly.
- * I've provided functions to do that for you. */
+/*  callback function pointer. The context is so that you can know which 
+    buffer initiated the callback. This is so that you can service multiple 
+    buffer callbacks with the same function if you desire. */
+typedef void (*BufferCallbackFunc)(Buffer *bufferContext);
+
+#ifdef BUFFER_ENABLE_STATISTICS
+typedef struct BufferStatistics BufferStatistics;
+
+struct BufferStatistics
+{
+    BufferIndex highWaterMark;
+    uint32_t bytesWritten;
+    uint32_t bytesRead;
+    uint32_t bytesDropped;
+    uint32_t bytesOverwritten;
+};
+
+/*  highWaterMark       the most bytes that have been in the buffer at once
+ * 
+ *  bytesWritten        every byte that was stored in the buffer
+ * 
+ *  bytesRead           every byte that was read or committed out of the buffer
+ * 
+ *  bytesDropped        bytes that were thrown away because the buffer was full
+ *                      and overwrite is disabled. Also the front of a block 
+ *                      that was too big to ever fit with overwrite enabled.
+ * 
+ *  bytesOverwritten    old bytes that were thrown away to make room for new 
+ *                      ones with overwrite enabled
+ */
+#endif
+
+/*  Buffer Object. You shouldn't really need to access anything in here 
+    directly. I've provided functions to do that for you. */
 struct Buffer
 {
-    // public
-    uint8_t count;
-    bool overflow;
+    volatile bool overflow;
     bool enableOverwrite;
     
     struct
     {
         //  Yo dawg. I heard you liked structs...
         uint8_t *buffer;
-        uint8_t size;
-        uint8_t head;
-        uint8_t tail;
-    } private; /** These should be treated as private variables and not modified
-    directly without the use of a function. Unfortunately, this is C, so I 
-    really can't stop you.*/
+        BufferIndex size;
+        volatile BufferIndex head;
+        volatile BufferIndex tail;
+        BufferCallbackFunc overflowCallbackFunc;
+        BufferIndex highWatermark;
+        BufferIndex lowWatermark;
+        BufferCallbackFunc highWatermarkCallbackFunc;
+        BufferCallbackFunc lowWatermarkCallbackFunc;
+        volatile uint8_t watermarkRaised;
+        volatile uint8_t watermarkCleared;
+        BufferCallbackFunc dataAvailableCallbackFunc;
+        BufferCallbackFunc spaceAvailableCallbackFunc;
+#ifdef BUFFER_ENABLE_STATISTICS
+        BufferStatistics statistics;
+#endif
+#ifdef BUFFER_ENABLE_CRC
+        uint16_t writeCrc;
+#endif
+    } private;
 };
 
-// ***** Function Prototypes ***************************************************
-
-/**
- * Initializes a Buffer object
+/* These variable should be treated as private. You should only access them   
+ * with the use of a function.
  * 
- * Sets up pointers to the buffer. Does not allow the buffer to overwrite
- * values by default
+ * buffer   A pointer to the array which will form your ring buffer
  * 
- * @param self  pointer to the Buffer type that you are going to use
+ * size     the size of your array
  * 
- * @param arrayIn  pointer to the array that you are going to use
+ * head     Keeps track of the current index of data being written into the
+ *          buffer. Only the writer changes this.
  * 
- * @param arrayInSize  the size of said array 
+ * tail     Keeps track of the current index of data being read out from the
+ *          buffer. Only the reader changes this.
  * 
- * @return none
- */
-void Buffer_Init(Buffer *self, uint8_t *arrayIn, uint8_t arrayInSize);
-
-/**
- * Initializes a Buffer object with overwrite boolean
+ * overflowCallbackFunc  Called when the buffer is full and overwrite is 
+ *                       disabled
  * 
- * Gives you a boolean that, when initialized as true, will allow the buffer 
- * to overwrite data once it is full.
+ * highWatermark    The count where the buffer gets throttled. Zero is off.
+ * lowWatermark     The count where it stops being throttled.
  * 
- * @param self  pointer to the Buffer type that you are going to use
+ * watermarkRaised  How many times the writer has reached the high watermark.
+ *                  Only the writer changes this.
  * 
- * @param arrayIn  pointer to the array that you are going to use
+ * watermarkCleared How many times the reader has come back down to the low 
+ *                  watermark. Only the reader changes this. When the two are 
+ *                  different, the buffer is throttled.
  * 
- * @param arrayInSize  the size of said array
+ * dataAvailableCallbackFunc    Called by the writer when the buffer stops 
+ *                              being empty
  * 
- * @param overwrite  enable overwrite of buffer data if true
+ * spaceAvailableCallbackFunc   Called by the reader when the buffer stops 
+ *                              being full
  * 
- * @return none
- */
-void Buffer_InitWithOverwrite(Buffer *self, uint8_t *arrayIn, uint8_t arrayInSize, bool overwrite);
-
-/**
- * Puts a char into the buffer. Updates the head.
- * 
- * @param self  pointer to the Buffer type that you are using
+ * statistics   The counters, if BUFFER_ENABLE_STATISTICS is defined. The 
+ *              reader only changes bytesRead. The writer changes the rest.
  * 
- * @param receivedChar  the char to store in the buffer
- * 
- * @return true if write was successful
+ * writeCrc     The CRC16 of everything written since the last reset, if 
+ *              BUFFER_ENABLE_CRC is defined. Only the writer changes this.
  */
+
+// ***** Function Prototypes ***************************************************
+
+void Buffer_Init(Buffer *self, uint8_t *arrayIn, BufferIndex arrayInSize);
+
+void Buffer_InitWithOverwrite(Buffer *self, uint8_t *arrayIn, BufferIndex arrayInSize, bool overwrite);
+
 void Buffer_WriteChar(Buffer *self, uint8_t receivedChar);
 
-/**
- * Reads a char from the buffer. Updates the tail.
- * 
- * @param self  pointer to the Buffer type that you are using
- * 
- * @return a char read from the buffer
- */
 uint8_t Buffer_ReadChar(Buffer*);
 
-/**
- * Gets the amount of data stored in the buffer
- * 
- * @param self  pointer to the Buffer type that you are using
- *
- * @return number of bytes in the buffer
- */
-uint8_t Buffer_GetCount(Buffer*);
+BufferIndex Buffer_Write(Buffer *self, const uint8_t *data, BufferIndex length);
+
+BufferIndex Buffer_Read(Buffer *self, uint8_t *data, BufferIndex length);
+
+BufferIndex Buffer_PeekContiguous(Buffer *self, uint8_t **data);
+
+void Buffer_CommitRead(Buffer *self, BufferIndex length);
+
+BufferIndex Buffer_ReserveContiguous(Buffer *self, uint8_t **data);
+
+void Buffer_CommitWrite(Buffer *self, BufferIndex length);
+
+BufferIndex Buffer_FindByte(Buffer *self, uint8_t value);
+
+BufferIndex Buffer_FrameAvailable(Buffer *self, uint8_t delimiter);
+
+BufferIndex Buffer_GetCount(Buffer*);
+
+BufferIndex Buffer_GetSpace(Buffer*);
 
-/**
- * A convenience function that tells you if the buffer is full.
- * 
- * @param self  pointer to the Buffer type that you are using
- * 
- * @return true if buffer is full
- */
 bool Buffer_IsFull(Buffer*);
 
-/**
- * A convenience function that tells you if there is something in the buffer
- * 
- * @param self  pointer to the Buffer type that you are using
- * 
- * @return true if buffer is not empty
- */
 bool Buffer_IsNotEmpty(Buffer*);
 
-/**
- * A convenience function that tells you if the buffer overflowed
- * 
- * The overflow flag is cleared when you call this function. It is also
- * cleared automatically when space appears in the buffer. 
- * 
- * @param self  pointer to the Buffer type that you are using
- * 
- * @return true if buffer did overflow
- */
 bool Buffer_DidOverflow(Buffer*);
 
-/**
- * A function pointer that is called when the buffer overflows.
- * 
- * Only works if you have overwrite disabled. If you set this function pointer, 
- * your function will automatically be called whenever the buffer tries to 
- * overwrite data. The overflow is also set.
- * 
- * @param self  pointer to the Buffer type that you are using
- * 
- * @param Function  format: void SomeFunction(void)
- */
-void Buffer_SetOverflowCallback(void (*Function)(void));
+void Buffer_SetOverflowCallback(Buffer *self, BufferCallbackFunc);
+
+void Buffer_SetWatermarks(Buffer *self, BufferIndex high, BufferIndex low);
+
+void Buffer_SetHighWatermarkCallback(Buffer *self, BufferCallbackFunc);
+
+void Buffer_SetLowWatermarkCallback(Buffer *self, BufferCallbackFunc);
+
+bool Buffer_IsThrottled(Buffer*);
+
+void Buffer_SetDataAvailableCallback(Buffer *self, BufferCallbackFunc);
+
+void Buffer_SetSpaceAvailableCallback(Buffer *self, BufferCallbackFunc);
+
+#ifdef BUFFER_ENABLE_STATISTICS
+void Buffer_GetStatistics(Buffer *self, BufferStatistics *statistics);
+
+void Buffer_ResetStatistics(Buffer *self);
+#endif
+
+#ifdef BUFFER_ENABLE_CRC
+uint16_t Buffer_CRC16(Buffer *self, BufferIndex length, uint16_t crc);
+
+uint32_t Buffer_CRC32(Buffer *self, BufferIndex length, uint32_t crc);
+
+uint16_t Buffer_GetWriteCRC(Buffer*);
+
+void Buffer_ResetWriteCRC(Buffer*);
+#endif
 
 #endif	/* BUFFER_H */
 
@@ -1,142 +1,419 @@
 /*******************************************************************************
  * Title: Basic UART
- * 
+ *
  * Author: Matthew Spinks
- * 
+ *
  * File: UART.c
- * 
+ *
  * Description:
- * 
+ *      All of the UARTs share this code. Each one only has its own UART object
+ *      and its own table of registers.
+ *
  * ****************************************************************************/
 
 #include <xc.h>
 #include "UART.h"
 
+#ifdef PROFILE_ENABLE
+#include "Profile.h"
+#else
+#define PROFILE_BEGIN(point)
+#define PROFILE_END(point)
+#endif
+
 // ***** Defines ***************************************************************
 
-#define RX_REG  RC1REG  // the receive register
-#define TX_REG  TX1REG  // the the transmit register
+/*  The DMA hardware is different for every part (and this PIC16 doesn't even
+    have one), so you'll need to define these for yours. A PIC18 K42 would use
+    its DMA1 registers, an STM32 would use its DMA stream registers, and so on.
+    Each one is given the UART, so you can pick the right DMA channel for it.
+
+    UART_DMA_TX_START(uart, address, length)    Start sending length bytes
+                                                from address to the TX register
+    UART_DMA_RX_START(uart, address, length)    Start receiving up to length
+                                                bytes from the RX register
+                                                into address
+    UART_DMA_RX_REMAINING(uart)                 The number of bytes the
+                                                receive DMA still has left */
+#ifdef UART_USE_DMA
+    #if !defined(UART_DMA_TX_START) || !defined(UART_DMA_RX_START) || !defined(UART_DMA_RX_REMAINING)
+        #error "Define the UART_DMA macros for your part to use UART_USE_DMA"
+    #endif
+#endif
+
+/*  This EUSART doesn't do flow control by itself, so RTS and CTS are just
+    regular pins. Every UART gets its own pin functions. Without flow control,
+    we're always clear to send. */
+#ifdef UART_USE_FLOW_CONTROL
+    #define IsClearToSend(self)     ((self)->isClearToSend == 0 || (self)->isClearToSend(self))
+#else
+    #define IsClearToSend(self)     true
+#endif
 
 // ***** Function Prototypes ***************************************************
 
+static void UARTTransmitEnable(UART *self);
+static void UARTTransmitDisable(UART *self);
+
+#ifdef UART_USE_FLOW_CONTROL
+static UART *FindReceiveBufferOwner(Buffer *rxBuffer);
+static void UARTReceiveHighWatermark(Buffer *rxBuffer);
+static void UARTReceiveLowWatermark(Buffer *rxBuffer);
+#endif
+
+#ifdef UART_USE_DMA
+static void UARTDMAReceiveStart(UART *self);
+#endif
 
 // ***** Global Variables ******************************************************
 
-// local function pointers
-void (*UARTTransmitFinishedCallback)(void);
-void (*UARTReceiveInterruptCallback)(void);
+const UARTRegisters UART1Registers =
+{
+    &RC1REG, &TX1REG,
+    &PIE3, _PIE3_RCIE_MASK,
+    &PIE3, _PIE3_TXIE_MASK,
+    &RC1STA, _RC1STA_OERR_MASK, _RC1STA_CREN_MASK
+};
+
+#ifdef UART_USE_FLOW_CONTROL
+// So that the watermark callbacks can find their UART
+static UART *flowControlInstances[UART_MAX_INSTANCES];
+#endif
 
 // *****************************************************************************
 
-void UARTInit(void)
-{
-    // I'm going to let the Code Configurator handle the initialization
-    // this time.
-    
-//    // disable interrupts before changing states
-//    PIE3bits.RCIE = 0;
-//    PIE3bits.TXIE = 0;
-//
-//    // Set the EUSART module to the options selected in the user interface.
-//
-//    // ABDOVF no_overflow; SCKP Non-Inverted; BRG16 16bit_generator; WUE disabled; ABDEN disabled; 
-//    BAUD1CON = 0x08;
-//
-//    // SPEN enabled; RX9 8-bit; CREN enabled; ADDEN disabled; SREN disabled; 
-//    RC1STA = 0x90;
-//
-//    // TX9 8-bit; TX9D 0; SENDB sync_break_complete; TXEN enabled; SYNC asynchronous; BRGH hi_speed; CSRC slave; 
-//    TX1STA = 0x24;
-//
-//    // Baud Rate = 115200; SP1BRGL 34; 
-//    SP1BRGL = 0x22;
-//
-//    // Baud Rate = 115200; SP1BRGH 0; 
-//    SP1BRGH = 0x00;
-//
-//    // enable receive interrupt
-//    PIE3bits.RCIE = 1;
+void UART_Init(UART *self, const UARTRegisters *regs, Buffer *rxBuffer, Buffer *txBuffer)
+{
+    // I'm going to let the Code Configurator handle the baud rate and the
+    // pins this time.
+    self->regs = regs;
+    self->rxBuffer = rxBuffer;
+    self->txBuffer = txBuffer;
+    self->transmitFinishedCallbackFunc = 0;
+    self->transmitSpaceCallbackFunc = 0;
+    self->waitingForSpace = false;
+
+#ifdef UART_USE_FLOW_CONTROL
+    self->setReadyToReceive = 0;
+    self->isClearToSend = 0;
+#endif
+
+#ifdef UART_USE_DMA
+    self->dmaTxLength = 0;
+    self->dmaRxLength = 0;
+    self->dmaRxCommitted = 0;
+#endif
+
+    UART_ReceiveEnable(self);
 }
 
 // ----- UART Transmit  --------------------------------------------------------
 
-//void UARTTransmitFinished()
-//{
-//    if(UARTTransmitFinishedCallback)
-//    {
-//        UARTTransmitFinishedCallback();
-//    }
-//}
-
-void UARTTransmitChar(uint8_t data)
+BufferIndex UART_Send(UART *self, const uint8_t *data, BufferIndex length)
 {
-    // For this function I will be making use of interrupts to transmit my data.
-    // Writing to TX_REG will clear the TXIF flag after one instruction cycle
-    TX_REG = data;
-    
-    // TODO make function call
-    PIE3bits.TXIE = 1; // enable transmit interrupt
+    BufferIndex space = Buffer_GetSpace(self->txBuffer);
+
+    if(length > space)
+    {
+        length = space;
+        self->waitingForSpace = true;
+    }
+
+    if(length != 0)
+    {
+        Buffer_Write(self->txBuffer, data, length);
+
+        // One kick for the whole batch
+        UART_TransmitStart(self);
+    }
+    return length;
 }
 
-void UARTTransmitEnable()
+void UART_TransmitStart(UART *self)
 {
-    PIE3bits.TXIE = 1;
+#ifdef UART_USE_DMA
+    UART_DMATransmitStart(self);
+#else
+    UARTTransmitEnable(self);
+#endif
 }
 
-void UARTTransmitDisable()
+void UART_TransmitInterrupt(UART *self)
 {
-    PIE3bits.TXIE = 0;
+    PROFILE_BEGIN(PROFILE_UART_TRANSMIT_ISR);
+
+    // Is there more data in the TX buffer to send?
+    if(!IsClearToSend(self))
+    {
+        // The other end wants us to stop. UART_ClearToSendChanged will start
+        // us back up.
+        UARTTransmitDisable(self);
+    }
+    else if(Buffer_IsNotEmpty(self->txBuffer))
+    {
+        *self->regs->transmit = Buffer_ReadChar(self->txBuffer); // Place in the tx register
+
+        if(self->waitingForSpace)
+        {
+            self->waitingForSpace = false;
+
+            if(self->transmitSpaceCallbackFunc)
+            {
+                self->transmitSpaceCallbackFunc(self);
+            }
+        }
+    }
+    else
+    {
+        UARTTransmitDisable(self); // Disable the transmit interrupt
+
+        if(self->transmitFinishedCallbackFunc)
+        {
+            self->transmitFinishedCallbackFunc(self);
+        }
+    }
+    PROFILE_END(PROFILE_UART_TRANSMIT_ISR);
 }
 
 // ----- UART Receive ----------------------------------------------------------
 
-// The receive interrupt and the actual receive char are two separate 
-// functions. This makes things a more flexible when interfacing to some sort
-// of interrupt manager.
+void UART_ReceiveInterrupt(UART *self)
+{
+    const UARTRegisters *regs = self->regs;
+    PROFILE_BEGIN(PROFILE_UART_RECEIVE_ISR);
+
+    if(*regs->status & regs->overrunMask)
+    {
+        // EUSART error - restart
+        *regs->status &= ~regs->continuousReceiveMask;
+        *regs->status |= regs->continuousReceiveMask;
+    }
+
+    Buffer_WriteChar(self->rxBuffer, *regs->receive);
+
+    PROFILE_END(PROFILE_UART_RECEIVE_ISR);
+}
+
+void UART_ReceiveEnable(UART *self)
+{
+    *self->regs->receiveInterruptEnable |= self->regs->receiveInterruptMask;
+}
+
+void UART_ReceiveDisable(UART *self)
+{
+    *self->regs->receiveInterruptEnable &= ~self->regs->receiveInterruptMask;
+}
+
+// ----- UART Flow Control -----------------------------------------------------
+
+#ifdef UART_USE_FLOW_CONTROL
+
+bool UART_FlowControlInit(UART *self, BufferIndex highWatermark, BufferIndex lowWatermark,
+        void (*setReadyToReceive)(UART *self, bool ready), bool (*isClearToSend)(UART *self))
+{
+    uint8_t i;
+
+    for(i = 0; i < UART_MAX_INSTANCES; i++)
+    {
+        if(flowControlInstances[i] == 0 || flowControlInstances[i] == self)
+        {
+            flowControlInstances[i] = self;
+            break;
+        }
+    }
+
+    // The watermark callbacks would have no way to find us. Leave the
+    // buffer alone rather than have them drive somebody else's pins.
+    if(i == UART_MAX_INSTANCES)
+        return false;
+
+    self->setReadyToReceive = setReadyToReceive;
+    self->isClearToSend = isClearToSend;
+
+    Buffer_SetWatermarks(self->rxBuffer, highWatermark, lowWatermark);
+    Buffer_SetHighWatermarkCallback(self->rxBuffer, UARTReceiveHighWatermark);
+    Buffer_SetLowWatermarkCallback(self->rxBuffer, UARTReceiveLowWatermark);
+
+    // We're empty, so go ahead
+    if(self->setReadyToReceive)
+        self->setReadyToReceive(self, true);
+
+    return true;
+}
+
+void UART_ClearToSendChanged(UART *self)
+{
+    if(!IsClearToSend(self))
+        return;
+
+    // Pick up wherever we left off
+    if(Buffer_IsNotEmpty(self->txBuffer))
+        UART_TransmitStart(self);
+}
+
+#endif
+
+// ----- UART DMA --------------------------------------------------------------
 
-//void UARTReceiveInterrupt()
-//{
-//    if(1 == RC1STAbits.OERR)
-//    {
-//        // EUSART error - restart
-//        RC1STAbits.CREN = 0;
-//        RC1STAbits.CREN = 1;
-//    }
-//    
-//    if(UARTReceiveInterruptCallback)
-//    {
-//        UARTReceiveInterruptCallback();
-//    }
-//}
+#ifdef UART_USE_DMA
 
-uint8_t UARTGetReceivedChar()
+void UART_DMAInit(UART *self)
 {
-    return RX_REG;
+    self->dmaTxLength = 0;
+
+    // The receive interrupt is replaced by the DMA
+    UART_ReceiveDisable(self);
+    UARTDMAReceiveStart(self);
+}
+
+void UART_DMATransmitStart(UART *self)
+{
+    uint8_t *data;
+    BufferIndex length;
+
+    // If it's busy, the transmit complete will take care of the new data
+    if(self->dmaTxLength != 0)
+        return;
+
+    // The block that is already going will still finish, so keep the blocks
+    // small if the other end can't take much after it drops CTS.
+    if(!IsClearToSend(self))
+        return;
+
+    length = Buffer_PeekContiguous(self->txBuffer, &data);
+
+    if(length != 0)
+    {
+        self->dmaTxLength = length;
+        UART_DMA_TX_START(self, data, length);
+    }
+}
+
+void UART_DMATransmitComplete(UART *self)
+{
+    // The whole block is gone. Free it up and go again.
+    Buffer_CommitRead(self->txBuffer, self->dmaTxLength);
+    self->dmaTxLength = 0;
+    UART_DMATransmitStart(self);
+
+    if(self->waitingForSpace)
+    {
+        self->waitingForSpace = false;
+
+        if(self->transmitSpaceCallbackFunc)
+        {
+            self->transmitSpaceCallbackFunc(self);
+        }
+    }
 }
 
-void UARTReceiveEnable()
+void UART_DMAReceiveEvent(UART *self)
 {
-    PIE3bits.RCIE = 1;
+    BufferIndex received;
+
+    if(self->dmaRxLength == 0)
+        return;
+
+    received = self->dmaRxLength - (BufferIndex)UART_DMA_RX_REMAINING(self);
+
+    // Only add the new bytes since the last event
+    Buffer_CommitWrite(self->rxBuffer, received - self->dmaRxCommitted);
+    self->dmaRxCommitted = received;
+
+    if(received == self->dmaRxLength)
+    {
+        // The block is full. Move on to the next free space.
+        UARTDMAReceiveStart(self);
+    }
 }
 
-void UARTReceiveDisable()
+void UART_DMAService(UART *self)
 {
-    PIE3bits.RCIE = 0;
+    if(self->dmaRxLength == 0)
+        UARTDMAReceiveStart(self);
 }
 
+#endif
+
 // ----- Set UART Transmit -----------------------------------------------------
 
-void SetUARTTransmitFinishedCallback(void (*Function)(void))
+void UART_SetTransmitFinishedCallback(UART *self, UARTCallbackFunc Function)
 {
-    UARTTransmitFinishedCallback = Function;
+    self->transmitFinishedCallbackFunc = Function;
 }
 
-// ----- Set UART Receive ------------------------------------------------------
+// ----- Set UART Transmit Space -----------------------------------------------
 
-void SetUARTReceiveInterruptCallback(void (*Function)(void))
+void UART_SetTransmitSpaceCallback(UART *self, UARTCallbackFunc Function)
 {
-    UARTReceiveInterruptCallback = Function;
+    self->transmitSpaceCallbackFunc = Function;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void UARTTransmitEnable(UART *self)
+{
+    *self->regs->transmitInterruptEnable |= self->regs->transmitInterruptMask;
+}
+
+static void UARTTransmitDisable(UART *self)
+{
+    *self->regs->transmitInterruptEnable &= ~self->regs->transmitInterruptMask;
+}
+
+#ifdef UART_USE_FLOW_CONTROL
+
+static UART *FindReceiveBufferOwner(Buffer *rxBuffer)
+{
+    uint8_t i;
+
+    for(i = 0; i < UART_MAX_INSTANCES; i++)
+    {
+        if(flowControlInstances[i] && flowControlInstances[i]->rxBuffer == rxBuffer)
+            return flowControlInstances[i];
+    }
+    return 0;
+}
+
+static void UARTReceiveHighWatermark(Buffer *rxBuffer)
+{
+    UART *self = FindReceiveBufferOwner(rxBuffer);
+
+    if(self && self->setReadyToReceive)
+        self->setReadyToReceive(self, false);
+}
+
+static void UARTReceiveLowWatermark(Buffer *rxBuffer)
+{
+    UART *self = FindReceiveBufferOwner(rxBuffer);
+
+    if(self && self->setReadyToReceive)
+        self->setReadyToReceive(self, true);
+}
+
+#endif
+
+#ifdef UART_USE_DMA
+
+static void UARTDMAReceiveStart(UART *self)
+{
+    uint8_t *space;
+    BufferIndex length = Buffer_ReserveContiguous(self->rxBuffer, &space);
+
+    self->dmaRxCommitted = 0;
+    self->dmaRxLength = length;
+
+    // If the buffer is full, we have to wait for UART_DMAService
+    if(length != 0)
+        UART_DMA_RX_START(self, space, length);
+}
+
+#endif
+
 /**
  End of File
-*/
\ No newline at end of file
+*/
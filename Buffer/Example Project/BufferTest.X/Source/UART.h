@@ -1,134 +1,369 @@
 /*******************************************************************************
  * Title: Basic UART Header
- * 
+ *
  * Author: Matthew Spinks
- * 
+ *
  * File: UART.h
- * 
+ *
  * Description:
- * 
+ *      A UART object, the same way Buffer works. Each UART gets tied to its
+ *      own registers, its own receive Buffer, and its own transmit Buffer.
+ *      Every UART runs through the same code, so if you have three or four
+ *      of them there is still only one copy of the driver to keep working.
+ *
+ *      The registers for each UART are in a UARTRegisters table. The one for
+ *      the EUSART on this part is provided as UART1Registers. For any other
+ *      UARTs, make one of your own with their registers.
+ *
+ *          UART uart1;
+ *          UART_DEFINE_ISR(UART1, uart1)
+ *          ...
+ *          UART_Init(&uart1, &UART1Registers, &rxBuffer, &txBuffer);
+ *          INTERRUPT_SetHandler(INTERRUPT_EUSART_RECEIVE, UART1ReceiveInterrupt);
+ *          INTERRUPT_SetHandler(INTERRUPT_EUSART_TRANSMIT, UART1TransmitInterrupt);
+ *
+ *      UART_DEFINE_ISR makes the little functions that the interrupt manager
+ *      calls for each UART. All they do is pass the right UART to the shared
+ *      interrupt code.
+ *
  * ****************************************************************************/
 
 #ifndef IUART_H
 #define	IUART_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "Buffer.h"
+
+// ***** Defines ***************************************************************
+
+/*  The most UARTs that can use flow control at once. The watermark callbacks
+    only get the Buffer, so this is how we find the UART that it belongs to. */
+#ifndef UART_MAX_INSTANCES
+#define UART_MAX_INSTANCES  4
+#endif
+
+/*  Makes the interrupt functions for one UART. Put this at file scope after
+    the UART is declared. For a UART called uart1 with a name of UART1, you
+    get UART1ReceiveInterrupt and UART1TransmitInterrupt. With UART_USE_DMA
+    you also get UART1DMATransmitComplete and UART1DMAReceiveEvent. */
+#ifdef UART_USE_DMA
+#define UART_DEFINE_ISR(name, instance) \
+    void name##ReceiveInterrupt(void) { UART_ReceiveInterrupt(&instance); } \
+    void name##TransmitInterrupt(void) { UART_TransmitInterrupt(&instance); } \
+    void name##DMATransmitComplete(void) { UART_DMATransmitComplete(&instance); } \
+    void name##DMAReceiveEvent(void) { UART_DMAReceiveEvent(&instance); }
+#else
+#define UART_DEFINE_ISR(name, instance) \
+    void name##ReceiveInterrupt(void) { UART_ReceiveInterrupt(&instance); } \
+    void name##TransmitInterrupt(void) { UART_TransmitInterrupt(&instance); }
+#endif
+
+// ***** Global Variables ******************************************************
+
+typedef struct UART UART;
+typedef struct UARTRegisters UARTRegisters;
+
+/*  callback function pointer. The context is so that you can know which UART
+    initiated the callback. This is so that you can service multiple UART
+    callbacks with the same function if you desire. */
+typedef void (*UARTCallbackFunc)(UART *uartContext);
+
+/*  Where everything is for one UART. Make these const so they stay in program
+    memory. */
+struct UARTRegisters
+{
+    volatile unsigned char *receive;
+    volatile unsigned char *transmit;
+    volatile unsigned char *receiveInterruptEnable;
+    uint8_t receiveInterruptMask;
+    volatile unsigned char *transmitInterruptEnable;
+    uint8_t transmitInterruptMask;
+    volatile unsigned char *status;
+    uint8_t overrunMask;
+    uint8_t continuousReceiveMask;
+};
+
+/*  receive             The receive register, like RC1REG
+ *
+ *  transmit            The transmit register, like TX1REG
+ *
+ *  receiveInterrupt    The register and bit that turn on the receive interrupt
+ *
+ *  transmitInterrupt   The register and bit that turn on the transmit
+ *                      interrupt
+ *
+ *  status              The receive status register, like RC1STA. If the
+ *                      overrun bit is set, the continuous receive bit gets
+ *                      turned off and on again to clear it.
+ */
+
+struct UART
+{
+    const UARTRegisters *regs;
+    Buffer *rxBuffer;
+    Buffer *txBuffer;
+
+    UARTCallbackFunc transmitFinishedCallbackFunc;
+    UARTCallbackFunc transmitSpaceCallbackFunc;
+
+    // Set when UART_Send had to turn data away
+    volatile bool waitingForSpace;
+
+#ifdef UART_USE_FLOW_CONTROL
+    void (*setReadyToReceive)(UART *self, bool ready);
+    bool (*isClearToSend)(UART *self);
+#endif
+
+#ifdef UART_USE_DMA
+    // How big the block was when each DMA was started
+    volatile BufferIndex dmaTxLength;
+    volatile BufferIndex dmaRxLength;
+
+    // How much of the current receive block is already in the buffer
+    volatile BufferIndex dmaRxCommitted;
+#endif
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * setReadyToReceive    Drives the RTS pin
+ *
+ * isClearToSend        Reads the CTS pin
+ */
+
+// The EUSART on the PIC16LF18855
+extern const UARTRegisters UART1Registers;
+
+// ***** Function Prototypes ***************************************************
 
 /* ----- Initialize UART -------------------------------------------------------
- * 
+ *
+ * Ties the UART to its registers and buffers and turns on the receive
+ * interrupt. The baud rate and the pins still need to be set up first, which
+ * I'm letting the Code Configurator do.
+ *
  * Parameters:
- *      None
- * 
+ *      The UART, its registers, the Buffer to receive into, and the Buffer to
+ *      transmit from
+ *
  * Returns:
  *      None
  */
-void UARTInit(void);
+void UART_Init(UART *self, const UARTRegisters *regs, Buffer *rxBuffer, Buffer *txBuffer);
 
 /* ----- Enable UART Receive ---------------------------------------------------
- * 
+ *
  * Parameters:
- *      None
- * 
+ *      The UART
+ *
  * Returns:
  *      None
  */
-void UARTReceiveEnable(void);
+void UART_ReceiveEnable(UART *self);
 
 /* ----- Disable UART Receive --------------------------------------------------
- * 
+ *
  * Parameters:
- *      None
- * 
+ *      The UART
+ *
  * Returns:
  *      None
  */
-void UARTReceiveDisable(void);
+void UART_ReceiveDisable(UART *self);
 
 /* ----- UART Receive Interrupt ------------------------------------------------
- * 
- * To be called upon when a character is received from the UART. Either via 
- * an interrupt, or by other means. From here you must either do something
- * with the data, pass it along to another event handler.
- * 
+ *
+ * To be called when a character is received. The character goes in the UART's
+ * receive buffer. Use the functions made by UART_DEFINE_ISR to call this from
+ * the interrupt manager.
+ *
  * Parameters:
- *      None
- * 
+ *      The UART
+ *
  * Returns:
  *      None
  */
-void UARTReceiveInterrupt(void);
+void UART_ReceiveInterrupt(UART *self);
 
-/* ----- UART Receive ----------------------------------------------------------
- * 
+/* ----- UART Transmit Interrupt -----------------------------------------------
+ *
+ * To be called when the transmit register is empty. Sends the next byte from
+ * the transmit buffer, or turns the interrupt off if there's nothing left.
+ *
  * Parameters:
+ *      The UART
+ *
+ * Returns:
  *      None
- * 
+ */
+void UART_TransmitInterrupt(UART *self);
+
+/* ----- UART Send -------------------------------------------------------------
+ *
+ * Puts as much of your data as will fit in the transmit buffer and starts
+ * sending it. This never waits for space. If the buffer is full, you get back
+ * fewer bytes than you asked for, and it is up to you to send the rest later.
+ * The transmit interrupt is only turned on once for the whole batch.
+ *
+ * Parameters:
+ *      The UART, a pointer to the data, and the number of bytes to send
+ *
  * Returns:
- *      The data from the UART register
+ *      The number of bytes that were accepted
  */
-uint8_t UARTGetReceivedChar(void);
+BufferIndex UART_Send(UART *self, const uint8_t *data, BufferIndex length);
 
-/* ----- Enable UART Transmit --------------------------------------------------
- * 
+/* ----- UART Transmit Start ---------------------------------------------------
+ *
+ * If you put data in the transmit buffer yourself, like with COBS, call this
+ * afterwards to get it going.
+ *
  * Parameters:
- *      None
- * 
+ *      The UART
+ *
  * Returns:
  *      None
  */
-void UARTTransmitEnable(void);
+void UART_TransmitStart(UART *self);
 
-/* ----- Disable UART Transmit -------------------------------------------------
- * 
+/* ----- UART Set Callbacks ----------------------------------------------------
+ *
+ * The finished callback happens from the transmit interrupt once the buffer
+ * is empty. The space callback happens from the transmit interrupt as soon as
+ * there is space again, if UART_Send couldn't take all of your data. Use it
+ * to send the rest of your data or to wake up whatever is waiting to send.
+ *
  * Parameters:
- *      None
- * 
+ *      The UART, and format: void SomeFunction(UART *uartContext)
+ *
+ * Returns:
+ *      None.
+ */
+void UART_SetTransmitFinishedCallback(UART *self, UARTCallbackFunc Function);
+void UART_SetTransmitSpaceCallback(UART *self, UARTCallbackFunc Function);
+
+#ifdef UART_USE_FLOW_CONTROL
+
+/* ----- Initialize UART Flow Control ------------------------------------------
+ *
+ * Only available when UART_USE_FLOW_CONTROL is defined. Sets the watermarks
+ * on the receive buffer and uses them to drive the RTS pin. When the buffer
+ * fills up to the high watermark, RTS tells the other end to stop. When it
+ * drains down to the low watermark, RTS lets it send again. The room above
+ * the high watermark has to hold whatever the other end sends before it
+ * notices, which is usually a few bytes. The transmitter also stops whenever
+ * the other end drops CTS.
+ *
+ * The pins are up to you. Give it one function that sets RTS and one that
+ * reads CTS. If you only want one of them, pass a zero for the other.
+ *
+ * Only UART_MAX_INSTANCES UARTs can use flow control. If they are all taken,
+ * nothing is set up and the UART runs without it.
+ *
+ * Parameters:
+ *      The UART, the count to stop the other end at, the count to let it
+ *      start again at, and the two pin functions
+ *
+ * Returns:
+ *      False if there was no room for another UART with flow control
+ */
+bool UART_FlowControlInit(UART *self, BufferIndex highWatermark, BufferIndex lowWatermark,
+        void (*setReadyToReceive)(UART *self, bool ready), bool (*isClearToSend)(UART *self));
+
+/* ----- UART Clear To Send Changed --------------------------------------------
+ *
+ * Call this from the interrupt-on-change for the CTS pin, or just poll it from
+ * your main loop. If the other end is ready again, the transmitter is started
+ * back up where it left off.
+ *
+ * Parameters:
+ *      The UART
+ *
  * Returns:
  *      None
  */
-void UARTTransmitDisable(void);
+void UART_ClearToSendChanged(UART *self);
 
-/* ----- UART Transmit ---------------------------------------------------------
- * 
- * First, it prepares a byte to be transmitted by UART. Either by an interrupt, 
- * or other means. Then it should enable the transmitter
- * 
+#endif
+
+#ifdef UART_USE_DMA
+
+/* ----- Initialize UART DMA ---------------------------------------------------
+ *
+ * Only available when UART_USE_DMA is defined. Instead of an interrupt for
+ * every byte, the DMA moves data straight in and out of the buffers. The
+ * transmit DMA is pointed at the data waiting in the transmit buffer and the
+ * receive DMA is pointed at the free space in the receive buffer. The buffers
+ * are updated a whole block at a time whenever the DMA tells us something
+ * happened. This also starts the receive DMA.
+ *
  * Parameters:
- *      The data to transmit over the UART. The register names will be
- *      implemented based on the processor.
- * 
+ *      The UART
+ *
  * Returns:
- *      None.
+ *      None
  */
-void UARTTransmitChar(uint8_t);
+void UART_DMAInit(UART *self);
 
-/* ----- UART Transmit Finished ------------------------------------------------
- * 
- * To be called upon whenever UART transmission has finished. If you are using 
- * interrupts, this would be typically be your TX interrupt function.
- * 
+/* ----- UART DMA Transmit Start -----------------------------------------------
+ *
+ * UART_Send does this for you. If the transmit DMA isn't already busy, it
+ * gets started on the data in the buffer. If it is busy, the new data will
+ * be picked up when the current block is finished.
+ *
  * Parameters:
+ *      The UART
+ *
+ * Returns:
  *      None
- * 
+ */
+void UART_DMATransmitStart(UART *self);
+
+/* ----- UART DMA Transmit Complete --------------------------------------------
+ *
+ * To be called from your transmit DMA complete interrupt. The block that was
+ * sent is removed from the transmit buffer and the next block is started.
+ *
+ * Parameters:
+ *      The UART
+ *
  * Returns:
- *      None.
+ *      None
  */
-void UARTTransmitFinished(void);
+void UART_DMATransmitComplete(UART *self);
 
-/* ----- UART Transmit Finished ------------------------------------------------
- * 
- * 
- * 
+/* ----- UART DMA Receive Event ------------------------------------------------
+ *
+ * To be called from your receive DMA half complete and complete interrupts,
+ * and from the UART idle line interrupt if your part has one. Whatever has
+ * arrived so far is added to the receive buffer. If the DMA filled its whole
+ * block, it is started again on the next free space.
+ *
  * Parameters:
+ *      The UART
+ *
+ * Returns:
  *      None
- * 
+ */
+void UART_DMAReceiveEvent(UART *self);
+
+/* ----- UART DMA Service ------------------------------------------------------
+ *
+ * Call this from your main loop after reading from the receive buffer. If the
+ * receive buffer filled up, the receive DMA had to stop. This starts it again
+ * once there is space.
+ *
+ * Parameters:
+ *      The UART
+ *
  * Returns:
- *      None.
+ *      None
  */
+void UART_DMAService(UART *self);
 
-void SetUARTTransmitFinishedCallback(void (*Function)(void));
-void SetUARTReceiveInterruptCallback(void (*Function)(void));
+#endif
 
 
 #endif	/* IUART_H */
-
@@ -17,12 +17,21 @@
 
 // ***** Defines ***************************************************************
 
+// If you're not sure how big these need to be, define BUFFER_ENABLE_STATISTICS
+// and look at Buffer_GetStatistics after running under a real load.
 #define RX_BUFF_SIZE    32
 #define TX_BUFF_SIZE    32
 
+// Where RTS stops and starts the other end, if UART_USE_FLOW_CONTROL is on
+#define RX_HIGH_WATERMARK   (RX_BUFF_SIZE - 8)
+#define RX_LOW_WATERMARK    (RX_BUFF_SIZE / 4)
+
 // ***** Function Prototypes ***************************************************
 
-void TransmitChar(uint8_t);
+#ifdef UART_USE_FLOW_CONTROL
+static void UART1SetReadyToReceive(UART *self, bool ready);
+static bool UART1IsClearToSend(UART *self);
+#endif
 
 // ***** Global Variables ******************************************************
 
@@ -34,6 +43,13 @@ uint8_t txArray[TX_BUFF_SIZE];
 Buffer rxBuffer;
 Buffer txBuffer;
 
+// The UART ties the two buffers to the EUSART
+UART uart1;
+
+// Makes UART1ReceiveInterrupt and UART1TransmitInterrupt for the interrupt
+// manager
+UART_DEFINE_ISR(UART1, uart1)
+
 // *****************************************************************************
 
 void main(void)
@@ -46,37 +62,54 @@ void main(void)
 
 // ----- Initialize ------------------------------------------------------------
         
-    uint8_t receivedData;
-    
-    // Set function pointers for interrupt_manager -> UART Interface
-    Set_EUSART_Receive_ISR(UARTReceiveInterrupt);
-    Set_EUSART_Transmit_ISR(UARTTransmitFinished);
-    
-    /* This time around I'm going to implement the receive interrupt directly
-     * here in main. In the past, I used a callback function and handled it
-     *  inside a related c file. In either case, whichever file the receive
-     * interrupt function is in must interface with both the UART and the 
-     * buffer. If it is in a different c file, create function pointers to
-     * get the data from the interrupt to the buffer and vice versa. */
+    uint8_t *receivedData;
+    BufferIndex receivedLength;
     
     // Call the normal init function which has the default overwrite 
     // set to false.
     Buffer_Init(&rxBuffer, rxArray, RX_BUFF_SIZE);
     Buffer_Init(&txBuffer, txArray, TX_BUFF_SIZE);
     
+    /* The UART is an object now, just like the buffers. It owns its receive
+     * and transmit buffers, and the interrupt code is shared by every UART.
+     * If you have more than one, give each one its own buffers and its own
+     * UART_DEFINE_ISR. */
+    UART_Init(&uart1, &UART1Registers, &rxBuffer, &txBuffer);
+    
+    // Set function pointers for interrupt_manager -> UART Interface
+    INTERRUPT_SetHandler(INTERRUPT_EUSART_RECEIVE, UART1ReceiveInterrupt);
+    INTERRUPT_SetHandler(INTERRUPT_EUSART_TRANSMIT, UART1TransmitInterrupt);
+    
+#ifdef UART_USE_FLOW_CONTROL
+    // Tell the other end to wait before the receive buffer overflows
+    UART_FlowControlInit(&uart1, RX_HIGH_WATERMARK, RX_LOW_WATERMARK,
+            UART1SetReadyToReceive, UART1IsClearToSend);
+#endif
+    
+#ifdef UART_USE_DMA
+    // Let the DMA move the data instead of the byte interrupts
+    UART_DMAInit(&uart1);
+#endif
+    
     while (1)
     {
 // ----- Main Loop -------------------------------------------------------------
         
-        // Test loop back
-        if(Buffer_IsNotEmpty(&rxBuffer))
+        // Test loop back. Send the received data straight out of the 
+        // receive buffer. Whatever doesn't fit in the transmit buffer stays 
+        // where it is until the next time around, so we never have to wait.
+        receivedLength = Buffer_PeekContiguous(&rxBuffer, &receivedData);
+        
+        if(receivedLength != 0)
         {
-            receivedData = Buffer_ReadChar(&rxBuffer);
-            
-            // loop back
-            TransmitChar(receivedData);
+            receivedLength = UART_Send(&uart1, receivedData, receivedLength);
+            Buffer_CommitRead(&rxBuffer, receivedLength);
         }
         
+#ifdef UART_USE_DMA
+        UART_DMAService(&uart1);
+#endif
+        
     } // end main loop
     
 } // end main
@@ -87,60 +120,28 @@ void main(void)
 //                                                                            //
 ////////////////////////////////////////////////////////////////////////////////
 
-// ----- UART Receive Interrupt ------------------------------------------------
-    
-void UARTReceiveInterrupt()
-{
-    uint8_t receivedChar = UARTGetReceivedChar();
-    Buffer_WriteChar(&rxBuffer, receivedChar);
-}
+// The receive and transmit interrupts now live in UART.c, and are shared by 
+// every UART.
+
+#ifdef UART_USE_FLOW_CONTROL
 
-// ----- UART Transmit Interrupt -----------------------------------------------
+// ----- UART Flow Control Pins ------------------------------------------------
 
-void UARTTransmitFinished()
+// Use whichever pins you wired up. Both are active low.
+static void UART1SetReadyToReceive(UART *self, bool ready)
 {
-    uint8_t dataToSend;
-    
-    // Is there more data in the TX buffer to send?
-    if(Buffer_IsNotEmpty(&txBuffer))
-    {
-        dataToSend = Buffer_ReadChar(&txBuffer);
-        UARTTransmitChar(dataToSend); // Place in the tx register
-    }
-    else
-    {
-        UARTTransmitDisable(); // Disable the transmit interrupt
-    }
+    (void)self;
+    LATCbits.LATC4 = ready ? 0 : 1;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-//                                                                            //
-// ***** Local Functions *****************************************************//
-//                                                                            //
-////////////////////////////////////////////////////////////////////////////////
-
-// I only have one UART right now. I may eventually expand the UART 
-// interface to be like the buffer interface.
-
-void TransmitChar(uint8_t dataToSend)
+static bool UART1IsClearToSend(UART *self)
 {
-    // This is just a helper function to automate the process of placing 
-    // data in the buffer and preparing it to be sent.
-    
-    // Wait for space in the buffer. Since my transmit is interrupt driven
-    // using an empty while-loop will work just fine. If it is not interrupt 
-    // driven, then you should include code in the wait loop that will transmit 
-    // one byte over the UART if the buffer is full.
-    UARTTransmitEnable();
-    
-    while(Buffer_IsFull(&txBuffer));
-    
-    UARTTransmitDisable();
-    
-    Buffer_WriteChar(&txBuffer, dataToSend);
-    
-    UARTTransmitEnable(); // Enable the transmit interrupt
+    (void)self;
+    return PORTCbits.RC5 == 0;
 }
+
+#endif
+
 /**
  End of File
 */
\ No newline at end of file
@@ -1,47 +1,153 @@
 /*******************************************************************************
- * Title:
+ * Title: Interrupt Manager
  * 
  * Author: Matthew Spinks
  * 
  * File: interrupt_manager.c
  * 
  * Description:
+ *      The tables hold where each source's enable and flag bits are. On these
+ *      parts, the enable bit in PIEx and the flag bit in PIRx are always in 
+ *      the same spot, so one mask works for both. The tables are const so 
+ *      that they stay in program memory.
  * 
  * ****************************************************************************/
 
+#include <stdbool.h>
 #include "interrupt_manager.h"
 #include "mcc.h"
 
-void (*EUSART_Transmit_ISR)(void);
-void (*EUSART_Receive_ISR)(void);
+#ifdef PROFILE_ENABLE
+#include "Profile.h"
+#else
+#define PROFILE_BEGIN(point)
+#define PROFILE_END(point)
+#endif
+
+// ***** Defines ***************************************************************
+
+typedef struct
+{
+    volatile unsigned char *enable;
+    volatile unsigned char *flag;
+    uint8_t mask;
+    uint8_t source;
+    bool clearFlag;
+} InterruptEntry;
+
+/*  enable      The PIEx register
+ *  flag        The PIRx register
+ *  mask        The bit for this source in both of them
+ *  source      Which handler to call
+ *  clearFlag   If true, the manager clears the flag before calling the 
+ *              handler. Use this for flags that don't clear themselves, like
+ *              the timer flags. */
+
+#define NumEntries(table)   (sizeof(table) / sizeof(table[0]))
+
+// ***** Function Prototypes ***************************************************
+
+static void ServiceTable(const InterruptEntry *table, uint8_t numEntries);
+
+// ***** Global Variables ******************************************************
+
+/*  The order here is the order they get serviced in. Receive goes first. If a
+    byte comes in while we're transmitting, it has a lot less time to wait. */
+#ifdef INTERRUPT_USE_PRIORITY
+static const InterruptEntry highPriorityTable[] =
+{
+    {&PIE3, &PIR3, _PIE3_RCIE_MASK, INTERRUPT_EUSART_RECEIVE, false},
+};
+
+static const InterruptEntry lowPriorityTable[] =
+{
+    {&PIE3, &PIR3, _PIE3_TXIE_MASK, INTERRUPT_EUSART_TRANSMIT, false},
+};
+#else
+static const InterruptEntry interruptTable[] =
+{
+    {&PIE3, &PIR3, _PIE3_RCIE_MASK, INTERRUPT_EUSART_RECEIVE, false},
+    {&PIE3, &PIR3, _PIE3_TXIE_MASK, INTERRUPT_EUSART_TRANSMIT, false},
+};
+#endif
+
+static void (*interruptHandlers[INTERRUPT_NUM_SOURCES])(void);
+
+// *****************************************************************************
+
+#ifdef INTERRUPT_USE_PRIORITY
+
+void interrupt high_priority INTERRUPT_InterruptManagerHigh(void)
+{
+    ServiceTable(highPriorityTable, NumEntries(highPriorityTable));
+}
+
+void interrupt low_priority INTERRUPT_InterruptManagerLow(void)
+{
+    PROFILE_BEGIN(PROFILE_INTERRUPT_MANAGER);
+    
+    ServiceTable(lowPriorityTable, NumEntries(lowPriorityTable));
+    
+    PROFILE_END(PROFILE_INTERRUPT_MANAGER);
+}
+
+#else
 
 void interrupt INTERRUPT_InterruptManager (void)
 {
-   // interrupt handler
-    if(PIE3bits.TXIE == 1 && PIR3bits.TXIF == 1)
-    {
-        EUSART_Transmit_ISR();
-    }
-    else if(PIE3bits.RCIE == 1 && PIR3bits.RCIF == 1)
-    {
-        EUSART_Receive_ISR();
-    }
-    else
-    {
-        //Unhandled Interrupt
-    }
+    PROFILE_BEGIN(PROFILE_INTERRUPT_MANAGER);
+    
+    ServiceTable(interruptTable, NumEntries(interruptTable));
+    
+    PROFILE_END(PROFILE_INTERRUPT_MANAGER);
 }
 
-void Set_EUSART_Transmit_ISR(void (*Function)(void))
+#endif
+
+void INTERRUPT_SetHandler(InterruptSource source, void (*Function)(void))
 {
-    EUSART_Transmit_ISR = Function;
+    if(source < INTERRUPT_NUM_SOURCES)
+        interruptHandlers[source] = Function;
 }
 
-void Set_EUSART_Receive_ISR(void (*Function)(void))
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void ServiceTable(const InterruptEntry *table, uint8_t numEntries)
 {
-    EUSART_Receive_ISR = Function;
+    void (*handler)(void);
+    bool serviced;
+    uint8_t i;
+    
+    // Keep going around until nothing is left. Anything that came in while
+    // we were busy gets handled now instead of in another interrupt.
+    do
+    {
+        serviced = false;
+        
+        for(i = 0; i < numEntries; i++)
+        {
+            if((*table[i].enable & *table[i].flag & table[i].mask) == 0)
+                continue;
+            
+            if(table[i].clearFlag)
+                *table[i].flag &= ~table[i].mask;
+            
+            handler = interruptHandlers[table[i].source];
+            
+            if(handler)
+                handler();
+            else
+                *table[i].enable &= ~table[i].mask; // Nobody wants it. Turn it off.
+            
+            serviced = true;
+        }
+    } while(serviced);
 }
 
 /**
  End of File
-*/
\ No newline at end of file
+*/
@@ -1,28 +1,69 @@
 /*******************************************************************************
- * Title:
+ * Title: Interrupt Manager Header
  * 
  * Author: Matthew Spinks
  * 
  * File: interrupt_manager.h
  * 
  * Description:
+ *      Every interrupt source gets an entry in a table. Whenever the interrupt
+ *      happens, the manager goes down the table and calls the handler for 
+ *      every source that is enabled and has its flag set. It keeps going 
+ *      around until nothing is left, so a byte that comes in while we were 
+ *      busy transmitting gets handled in the same trip instead of needing a 
+ *      whole second interrupt. The order of the table is the order that the
+ *      sources are serviced in.
+ * 
+ *      On parts that have a high and a low priority interrupt, like the 
+ *      PIC18, define INTERRUPT_USE_PRIORITY. Then there is a table for each 
+ *      one. You still need to set the IPR bits for each source to match.
  * 
  * ****************************************************************************/
 
 #ifndef INTERRUPT_MANAGER_H
 #define INTERRUPT_MANAGER_H
 
+#include <stdint.h>
+
 #define INTERRUPT_GlobalInterruptEnable() (INTCONbits.GIE = 1)
 #define INTERRUPT_GlobalInterruptDisable() (INTCONbits.GIE = 0)
 #define INTERRUPT_PeripheralInterruptEnable() (INTCONbits.PEIE = 1)
 #define INTERRUPT_PeripheralInterruptDisable() (INTCONbits.PEIE = 0)
 
+/*  Everything that can have a handler. Add your source here and give it an 
+    entry in one of the tables in interrupt_manager.c */
+typedef enum InterruptSource InterruptSource;
+
+enum InterruptSource
+{
+    INTERRUPT_EUSART_RECEIVE,
+    INTERRUPT_EUSART_TRANSMIT,
+    INTERRUPT_NUM_SOURCES
+};
+
+#ifdef INTERRUPT_USE_PRIORITY
+void interrupt high_priority INTERRUPT_InterruptManagerHigh(void);
+void interrupt low_priority INTERRUPT_InterruptManagerLow(void);
+#else
 void interrupt INTERRUPT_InterruptManager(void);
+#endif
 
-void Set_EUSART_Transmit_ISR(void (*Function)(void));
-void Set_EUSART_Receive_ISR(void (*Function)(void));
+/* ----- Set Interrupt Handler -------------------------------------------------
+ * 
+ * Sets the function that gets called when the source's flag is set. The 
+ * handler has to clear the flag, like reading the receive register does, 
+ * unless the table entry says the manager clears it. If a source goes off 
+ * with no handler, the manager turns it off so that it can't get stuck.
+ * 
+ * Parameters:
+ *      The source, and the function to call. format: void SomeFunction(void)
+ * 
+ * Returns:
+ *      None
+ */
+void INTERRUPT_SetHandler(InterruptSource source, void (*Function)(void));
 
 #endif  // INTERRUPT_MANAGER_H
 /**
  End of File
-*/
\ No newline at end of file
+*/
@@ -13,30 +13,39 @@
 
 #include "Button.h"
 
+#ifdef PROFILE_ENABLE
+#include "Profile.h"
+#else
+#define PROFILE_BEGIN(point)
+#define PROFILE_END(point)
+#endif
+
 // ***** Defines ***************************************************************
 
 
 // ***** Function Prototypes ***************************************************
 
+static void SendEvent(Button *self, ButtonEvent event);
 
 // ***** Global Variables ******************************************************
 
+#ifdef BUTTON_EVENT_QUEUE
+// local function pointer
+static uint32_t (*Button_EventTimeSource)(void);
+#endif
 
 // ----- Initialize ------------------------------------------------------------
 
-void Button_InitMs(Button *self, uint16_t pressDebounceMs, uint16_t releaseDebounceMs, uint16_t tickMs)
+void Button_Init(Button *self, uint16_t pressDebounceTicks, uint16_t releaseDebounceTicks)
 {
-    Button_InitWithLongPressMs(self, pressDebounceMs, releaseDebounceMs, 0, tickMs);
+    Button_InitWithLongPress(self, pressDebounceTicks, releaseDebounceTicks, 0);
 }
 
-void Button_InitWithLongPressMs(Button *self, uint16_t pressDebounceMs, uint16_t releaseDebounceMs, uint16_t longPressMs, uint16_t tickMs)
+void Button_InitWithLongPress(Button *self, uint16_t pressDebounceTicks, uint16_t releaseDebounceTicks, uint16_t longPressTicks)
 {
-    if(tickMs != 0)
-    {
-        self->pressDebouncePeriod = pressDebounceMs / tickMs;
-        self->releaseDebouncePeriod = releaseDebounceMs / tickMs;
-        self->longPressPeriod = longPressMs / tickMs;
-    }
+    self->pressDebouncePeriod = pressDebounceTicks;
+    self->releaseDebouncePeriod = releaseDebounceTicks;
+    self->longPressPeriod = longPressTicks;
     
     // In case you accidentally initialize the long press period to zero or
     // a value less than one tick
@@ -46,12 +55,40 @@ void Button_InitWithLongPressMs(Button *self, uint16_t pressDebounceMs, uint16_t
         self->buttonType = LONG_PRESS_TYPE;
     
     self->buttonState = BUTTON_UP;
+    self->buttonCallbackFunc = 0;
+    self->edgePending = false;
+    self->flags.buttonDownEvent = 0;
+    self->flags.shortPress = 0;
+    self->flags.longPress = 0;
+    self->flags.buttonUpEvent = 0;
+    
+#ifdef BUTTON_EVENT_QUEUE
+    self->eventQueue = 0;
+#endif
+}
+
+void Button_InitMs(Button *self, uint16_t pressDebounceMs, uint16_t releaseDebounceMs, uint16_t tickMs)
+{
+    Button_InitWithLongPressMs(self, pressDebounceMs, releaseDebounceMs, 0, tickMs);
+}
+
+void Button_InitWithLongPressMs(Button *self, uint16_t pressDebounceMs, uint16_t releaseDebounceMs, uint16_t longPressMs, uint16_t tickMs)
+{
+    // These divides are done at run time. If your times are constants, 
+    // Button_InitWithLongPress and the Timebase macros are a lot cheaper.
+    if(tickMs == 0)
+        tickMs = 1;
+    
+    Button_InitWithLongPress(self, pressDebounceMs / tickMs, 
+        releaseDebounceMs / tickMs, longPressMs / tickMs);
 }
 
 // -----------------------------------------------------------------------------
 
 void Button_Tick(Button *self, bool isPressed)
 {
+    PROFILE_BEGIN(PROFILE_BUTTON_TICK);
+    
     switch(self->buttonState)
     {
         case BUTTON_UP:
@@ -61,15 +98,16 @@ void Button_Tick(Button *self, bool isPressed)
                 {
                     // If the debounce period is zero, we assume that 
                     // debouncing is being done via hardware
+                    self->flags.buttonDownEvent = 1;
+                    self->buttonState = BUTTON_DOWN;
+                    self->longPressCounter = 0;
+                    SendEvent(self, BUTTON_DOWN_EVENT);
+                    
                     if(self->buttonType == SHORT_PRESS_TYPE)
                     {
                         self->flags.shortPress = 1;
-                        
-                        // TODO callback function
+                        SendEvent(self, SHORT_PRESS_EVENT);
                     }
-                    self->flags.buttonDownEvent = 1;
-                    self->buttonState = BUTTON_DOWN;
-                    self->longPressCounter = 0;
                 }
                 else
                 {
@@ -86,16 +124,17 @@ void Button_Tick(Button *self, bool isPressed)
                 if(isPressed)
                 {
                     // Button debounced successfully
+                    self->flags.buttonDownEvent = 1;
+                    self->buttonState = BUTTON_DOWN;
+                    self->longPressCounter = 0;
+                    SendEvent(self, BUTTON_DOWN_EVENT);
+                    
                     if(self->buttonType == SHORT_PRESS_TYPE)
                     {
                         // We are finished.
                         self->flags.shortPress = 1;
-                        
-                        // TODO callback function
+                        SendEvent(self, SHORT_PRESS_EVENT);
                     }
-                    self->flags.buttonDownEvent = 1;
-                    self->buttonState = BUTTON_DOWN;
-                    self->longPressCounter = 0;
                 }
                 else
                 {
@@ -114,7 +153,10 @@ void Button_Tick(Button *self, bool isPressed)
                     self->longPressCounter++;
                     
                     if(self->longPressCounter == self->longPressPeriod)
+                    {
                         self->flags.longPress = 1;
+                        SendEvent(self, LONG_PRESS_EVENT);
+                    }
                 }
             }
             
@@ -133,10 +175,12 @@ void Button_Tick(Button *self, bool isPressed)
                         if(self->longPressCounter < self->longPressPeriod)
                         {
                             self->flags.shortPress = 1;
+                            SendEvent(self, SHORT_PRESS_EVENT);
                         }
                     }
                     self->flags.buttonUpEvent = 1;
                     self->buttonState = BUTTON_UP;
+                    SendEvent(self, BUTTON_UP_EVENT);
                 }
                 else
                 {
@@ -161,16 +205,21 @@ void Button_Tick(Button *self, bool isPressed)
                         if(self->longPressCounter < self->longPressPeriod)
                         {
                             self->flags.shortPress = 1;
+                            SendEvent(self, SHORT_PRESS_EVENT);
                         }
                     }
                     self->flags.buttonUpEvent = 1;
                     self->buttonState = BUTTON_UP;
+                    SendEvent(self, BUTTON_UP_EVENT);
                 }
                 else
                 {
-                    // We finished debouncing, but the button isn't being
-                    // pressed
-                    self->buttonState = BUTTON_UP;
+                    // It was only a bounce. The button is still being held,
+                    // so go back to timing the long press. Going to 
+                    // BUTTON_UP here would leave a held button looking like 
+                    // it was let go, and a ButtonGroup would never tick it 
+                    // again since its input doesn't change.
+                    self->buttonState = BUTTON_DOWN;
                 }
             }
             break;
@@ -178,6 +227,7 @@ void Button_Tick(Button *self, bool isPressed)
             
             break;
     }
+    PROFILE_END(PROFILE_BUTTON_TICK);
 }
 
 // -----------------------------------------------------------------------------
@@ -248,6 +298,107 @@ void Button_ClearButtonUpFlag(Button *self)
     self->flags.buttonUpEvent = 0;
 }
 
+// -----------------------------------------------------------------------------
+
+void Button_SetCallback(Button *self, ButtonCallbackFunc Function)
+{
+    self->buttonCallbackFunc = Function;
+}
+
+// -----------------------------------------------------------------------------
+
+void Button_EdgeDetected(Button *self)
+{
+    self->edgePending = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Button_ClearEdge(Button *self)
+{
+    // This has to happen before the pin is read. An edge after this is 
+    // either in the reading or it sets the flag again.
+    self->edgePending = false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Button_NeedsTick(Button *self)
+{
+    // The pin changed while nobody was ticking
+    if(self->edgePending)
+        return true;
+    
+    // A button only needs a tick when its input doesn't change if it is
+    // counting something. BUTTON_UP is only ever left behind by a tick that
+    // saw the button released, so a button that is up has nothing to wait
+    // for until the pin changes.
+    switch(self->buttonState)
+    {
+        case DEBOUNCE_PRESS:
+        case DEBOUNCE_RELEASE:
+            return true;
+        case BUTTON_DOWN:
+            if(self->buttonType == LONG_PRESS_TYPE &&
+                self->longPressCounter < self->longPressPeriod)
+                return true;
+            else
+                return false;
+        default:
+            return false;
+    }
+}
+
+#ifdef BUTTON_EVENT_QUEUE
+
+// -----------------------------------------------------------------------------
+
+void Button_SetEventQueue(Button *self, Queue *queue, uint8_t id)
+{
+    self->eventQueue = queue;
+    self->id = id;
+}
+
+// -----------------------------------------------------------------------------
+
+void Button_SetEventTimeSource(uint32_t (*Function)(void))
+{
+    Button_EventTimeSource = Function;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void SendEvent(Button *self, ButtonEvent event)
+{
+    if(self->buttonCallbackFunc)
+    {
+        self->buttonCallbackFunc(self, event);
+    }
+    
+#ifdef BUTTON_EVENT_QUEUE
+    if(self->eventQueue)
+    {
+        ButtonEventRecord record;
+        
+        record.id = self->id;
+        record.event = event;
+        record.timestamp = 0;
+        
+        if(Button_EventTimeSource)
+            record.timestamp = Button_EventTimeSource();
+        
+        // If the queue is full, the Queue's overflow flag tells you
+        Queue_Push(self->eventQueue, &record);
+    }
+#endif
+}
+
 /*
  End of File
  */
\ No newline at end of file
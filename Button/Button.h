@@ -8,6 +8,30 @@
  * @File Button.h
  * 
  * @Description
+ *      Debounces a button and turns it into events. You can either poll the
+ *      event flags, or set a callback function and be told when something
+ *      happens. The callback gets the Button that called it, just like a
+ *      Timer callback, so one function can handle all of your buttons.
+ * 
+ *      If you define BUTTON_EVENT_QUEUE, every event can also be put in a 
+ *      Queue as a ButtonEventRecord. Give all of your buttons the same Queue 
+ *      and a different id, and your main loop only has to check one place.
+ *      The Queue must be made with sizeof(ButtonEventRecord) items.
+ * 
+ *      A button that is sitting there not being pressed doesn't need to be 
+ *      ticked at all. Button_NeedsTick tells you when a button is in the 
+ *      middle of debouncing or timing a long press. When none of them are, 
+ *      stop your tick, turn on the interrupt-on-change for the button pins, 
+ *      and go to sleep. Have the interrupt-on-change call Button_EdgeDetected
+ *      and start your tick again. The next tick picks up the press and starts 
+ *      debouncing it like normal. Use both edges, since a button that was 
+ *      held past its long press also stops needing ticks until it lets go.
+ * 
+ *      The order matters. Every tick, call Button_ClearEdge first, then read
+ *      the pin, then call Button_Tick. If the edge comes after you read the 
+ *      pin, the flag is still set and Button_NeedsTick keeps you awake for 
+ *      another tick. If you cleared it after reading the pin, that edge 
+ *      would be lost and you could go to sleep with the button held down.
  * 
 *******************************************************************************/
 
@@ -19,6 +43,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef BUTTON_EVENT_QUEUE
+#include "Queue.h"
+#endif
+
 // ***** Defines ***************************************************************
 
 
@@ -27,6 +55,8 @@
 typedef struct Button Button;
 typedef enum ButtonState ButtonState;
 typedef enum ButtonType ButtonType;
+typedef enum ButtonEvent ButtonEvent;
+typedef struct ButtonEventRecord ButtonEventRecord;
 
 enum ButtonState
 {
@@ -53,8 +83,28 @@ enum ButtonType
     LONG_PRESS_TYPE,
 };
 
-/*  callback function pointers */
-//typedef void (*TimerCallbackFunc)(Timer *timerContext); // TODO
+/* The same events as the flags in the Button object */
+enum ButtonEvent
+{
+    BUTTON_DOWN_EVENT,
+    SHORT_PRESS_EVENT,
+    LONG_PRESS_EVENT,
+    BUTTON_UP_EVENT,
+};
+
+/*  callback function pointer. The context is so that you can know which 
+    button initiated the callback. This is so that you can service multiple 
+    button callbacks with the same function if you desire. */
+typedef void (*ButtonCallbackFunc)(Button *buttonContext, ButtonEvent event);
+
+/* What gets put in the event queue. The timestamp comes from the function you
+ * give to Button_SetEventTimeSource, or zero if you didn't give one. */
+struct ButtonEventRecord
+{
+    uint8_t id;
+    uint8_t event;
+    uint32_t timestamp;
+};
 
 /* Button object with counters and flags (with bit field) */
 struct Button
@@ -67,7 +117,15 @@ struct Button
  
     ButtonState buttonState;
     ButtonType buttonType;
-    //TimerCallbackFunc TimerCallbackFunc;
+    ButtonCallbackFunc buttonCallbackFunc;
+    
+    // set by the interrupt-on-change
+    volatile bool edgePending;
+    
+#ifdef BUTTON_EVENT_QUEUE
+    Queue *eventQueue;
+    uint8_t id;
+#endif
     
     // bit field for button events
     union {
@@ -87,10 +145,20 @@ struct Button
  * expired  This flag is set whenever the timer period reaches the specified 
  *          count. You must clear this flag yourself
  * 
+ * edgePending  Set by Button_EdgeDetected and cleared by Button_ClearEdge. 
+ *              Clear it before you read the pin, never after, or an edge in
+ *              between gets lost.
+ * 
  */
 
 // ***** Function Prototypes ***************************************************
 
+/*  The periods are in ticks, so there's nothing to divide. Use the macros in 
+    Timebase.h to turn milliseconds into ticks at compile time. */
+void Button_Init(Button *self, uint16_t pressDebounceTicks, uint16_t releaseDebounceTicks);
+
+void Button_InitWithLongPress(Button *self, uint16_t pressDebounceTicks, uint16_t releaseDebounceTicks, uint16_t longPressTicks);
+
 void Button_InitMs(Button *self, uint16_t pressDebounceMs, uint16_t releaseDebounceMs, uint16_t tickMs);
 
 void Button_InitWithLongPressMs(Button *self, uint16_t pressDebounceMs, uint16_t releaseDebounceMs, uint16_t longPressMs, uint16_t tickMs);
@@ -113,6 +181,18 @@ void Button_ClearButtonDownFlag(Button *self);
 
 void Button_ClearButtonUpFlag(Button *self);
 
-//void Timer_SetFinishedCallback(TimerCallbackFunc);
+void Button_SetCallback(Button *self, ButtonCallbackFunc Function);
+
+void Button_EdgeDetected(Button *self);
+
+void Button_ClearEdge(Button *self);
+
+bool Button_NeedsTick(Button *self);
+
+#ifdef BUTTON_EVENT_QUEUE
+void Button_SetEventQueue(Button *self, Queue *queue, uint8_t id);
+
+void Button_SetEventTimeSource(uint32_t (*Function)(void));
+#endif
 
 #endif	/* BUTTON_H */
\ No newline at end of file
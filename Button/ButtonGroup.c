@@ -0,0 +1,141 @@
+/* *****************************************************************************
+ * @Summary Button Group
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File ButtonGroup.c
+ *
+ * @Description
+ *      Handles a whole port of buttons at once. The input is compared with
+ *      the last input, and only the buttons that changed or that are in the
+ *      middle of something get a call to Button_Tick.
+ *
+*******************************************************************************/
+
+#include "ButtonGroup.h"
+
+// ***** Defines ***************************************************************
+
+
+// ***** Function Prototypes ***************************************************
+
+
+// ***** Global Variables ******************************************************
+
+
+// ----- Initialize ------------------------------------------------------------
+
+void ButtonGroup_Init(ButtonGroup *self, Button *buttons, uint8_t numButtons)
+{
+    if(numButtons > BUTTON_GROUP_SIZE)
+        numButtons = BUTTON_GROUP_SIZE;
+
+    self->buttons = buttons;
+    self->numButtons = numButtons;
+    self->lastInput = 0;
+    self->busy = 0;
+    self->edgePending = false;
+
+    // The counters start full so that the first input doesn't count as four
+    self->counterLow = (ButtonMask)~0;
+    self->counterHigh = (ButtonMask)~0;
+    self->debounced = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void ButtonGroup_Tick(ButtonGroup *self, ButtonMask input)
+{
+    // Only look at the buttons that changed or are still busy
+    ButtonMask work = (input ^ self->lastInput) | self->busy;
+    ButtonMask bit = 1;
+    uint8_t i = 0;
+
+    self->lastInput = input;
+
+    while(work != 0 && i < self->numButtons)
+    {
+        if(work & 1)
+        {
+            Button_Tick(&self->buttons[i], (input & bit) != 0);
+
+            // A button that is up while its input is pressed hasn't seen the
+            // press yet. Its input won't change again, so keep it busy.
+            if(Button_NeedsTick(&self->buttons[i]) || ((input & bit) &&
+                self->buttons[i].buttonState == BUTTON_UP))
+                self->busy |= bit;
+            else
+                self->busy &= ~bit;
+        }
+        work >>= 1;
+        bit <<= 1;
+        i++;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ButtonMask ButtonGroup_Debounce(ButtonGroup *self, ButtonMask input)
+{
+    /*  This is a two bit vertical counter. Each input gets its own two bit
+        counter, but the bits are stored sideways so that all of them count
+        at once. Any input that matches the debounced state has its counter
+        reset. Any input that is different counts down, and when it has been
+        different four ticks in a row, the debounced state flips. */
+    ButtonMask changed = self->debounced ^ input;
+
+    self->counterLow = ~(self->counterLow & changed);
+    self->counterHigh = self->counterLow ^ (self->counterHigh & changed);
+    changed &= self->counterLow & self->counterHigh;
+    self->debounced ^= changed;
+
+    // Tell them which inputs just flipped
+    return changed;
+}
+
+// -----------------------------------------------------------------------------
+
+ButtonMask ButtonGroup_GetDebounced(ButtonGroup *self)
+{
+    return self->debounced;
+}
+
+// -----------------------------------------------------------------------------
+
+void ButtonGroup_EdgeDetected(ButtonGroup *self)
+{
+    self->edgePending = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void ButtonGroup_ClearEdge(ButtonGroup *self)
+{
+    // Before the port is read, the same as Button_ClearEdge
+    self->edgePending = false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ButtonGroup_NeedsTick(ButtonGroup *self)
+{
+    // Every counter that isn't full is still in the middle of counting an
+    // input that changed
+    if(self->edgePending || self->busy != 0 ||
+        (ButtonMask)(self->counterLow & self->counterHigh) != (ButtonMask)~0)
+        return true;
+    else
+        return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+ End of File
+ */
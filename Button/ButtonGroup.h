@@ -0,0 +1,120 @@
+/* *****************************************************************************
+ * @Summary Button Group Header File
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File ButtonGroup.h
+ *
+ * @Description
+ *      Scans a whole port of buttons at once. Instead of calling Button_Tick
+ *      for every button, you read the port and hand the whole thing to
+ *      ButtonGroup_Tick. Bit 0 belongs to the first button in the array, bit
+ *      1 to the second, and so on. A bit that is 1 means that button is being
+ *      pressed. If your buttons are active low, invert the port first.
+ *
+ *      Most of the time, most of the buttons are sitting there doing nothing.
+ *      The group remembers the last state of the port and only calls
+ *      Button_Tick for the buttons that changed, or that are still busy
+ *      debouncing or timing a long press. All of the Button flags and
+ *      functions work the same as before.
+ *
+ *      If you don't need long presses and just want clean inputs, there's
+ *      also a vertical counter debounce. It debounces every bit in the port
+ *      at the same time with a few logic operations. A bit has to be the same
+ *      for four ticks in a row before it changes. This lets you skip the
+ *      Button objects altogether.
+ *
+ *      Once every button is back up and nothing is being counted,
+ *      ButtonGroup_NeedsTick says so, and you can stop ticking and sleep until
+ *      the interrupt-on-change calls ButtonGroup_EdgeDetected. That works
+ *      with either the buttons or the vertical counter. Like with Button, 
+ *      call ButtonGroup_ClearEdge before you read the port on every tick, 
+ *      not after, so that an edge in between can't be lost.
+ *
+ *      The size of the port is set by BUTTON_GROUP_SIZE. It can be 8, 16, or
+ *      32 buttons.
+ *
+*******************************************************************************/
+
+#ifndef BUTTON_GROUP_H
+#define	BUTTON_GROUP_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Button.h"
+
+// ***** Defines ***************************************************************
+
+#ifndef BUTTON_GROUP_SIZE
+#define BUTTON_GROUP_SIZE   8
+#endif
+
+// ***** Global Variables ******************************************************
+
+#if BUTTON_GROUP_SIZE == 32
+typedef uint32_t ButtonMask;
+#elif BUTTON_GROUP_SIZE == 16
+typedef uint16_t ButtonMask;
+#else
+typedef uint8_t ButtonMask;
+#endif
+
+typedef struct ButtonGroup ButtonGroup;
+
+struct ButtonGroup
+{
+    Button *buttons;
+    uint8_t numButtons;
+
+    ButtonMask lastInput;
+    ButtonMask busy;
+    volatile bool edgePending;
+
+    // vertical counter
+    ButtonMask counterLow;
+    ButtonMask counterHigh;
+    ButtonMask debounced;
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * buttons      The array of buttons. One for each bit
+ *
+ * lastInput    The port from the last tick
+ *
+ * busy         One bit for each button that is not sitting in BUTTON_UP. These
+ *              need to be ticked even if their input didn't change
+ *
+ * edgePending  Set by ButtonGroup_EdgeDetected and cleared by 
+ *              ButtonGroup_ClearEdge, which has to come before the port is 
+ *              read
+ *
+ * counterLow   The two bits of the vertical counter, one for each input
+ * counterHigh
+ *
+ * debounced    The debounced state of every input
+ *
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void ButtonGroup_Init(ButtonGroup *self, Button *buttons, uint8_t numButtons);
+
+void ButtonGroup_Tick(ButtonGroup *self, ButtonMask input);
+
+ButtonMask ButtonGroup_Debounce(ButtonGroup *self, ButtonMask input);
+
+ButtonMask ButtonGroup_GetDebounced(ButtonGroup *self);
+
+void ButtonGroup_EdgeDetected(ButtonGroup *self);
+
+void ButtonGroup_ClearEdge(ButtonGroup *self);
+
+bool ButtonGroup_NeedsTick(ButtonGroup *self);
+
+#endif	/* BUTTON_GROUP_H */
@@ -0,0 +1,272 @@
+/* *****************************************************************************
+ * @Summary Compact Button
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File CompactButton.c
+ *
+ * @Description
+ *      Works like Button_Tick, except everything about the key is in two
+ *      bytes and the periods come from the shared config.
+ *
+*******************************************************************************/
+
+#include "CompactButton.h"
+
+// ***** Defines ***************************************************************
+
+#define STATE_MASK          0x03
+#define BUTTON_DOWN_FLAG    0x04
+#define SHORT_PRESS_FLAG    0x08
+#define LONG_PRESS_FLAG     0x10
+#define BUTTON_UP_FLAG      0x20
+
+// The long press already happened, so the release isn't a short press
+#define LONG_REACHED        0x40
+
+#define GetState(self)          ((ButtonState)((self)->status & STATE_MASK))
+#define SetState(self, state)   ((self)->status = (uint8_t)(((self)->status & ~STATE_MASK) | (state)))
+
+// ***** Function Prototypes ***************************************************
+
+static void Pressed(CompactButton *self, const CompactButtonConfig *config);
+static void Released(CompactButton *self, const CompactButtonConfig *config);
+
+// ***** Global Variables ******************************************************
+
+
+// ----- Initialize ------------------------------------------------------------
+
+void CompactButton_Init(CompactButton *self)
+{
+    self->status = BUTTON_UP;
+    self->counter = 0;
+}
+
+void CompactButton_InitArray(CompactButton *keys, uint8_t numKeys)
+{
+    uint8_t i;
+
+    for(i = 0; i < numKeys; i++)
+        CompactButton_Init(&keys[i]);
+}
+
+// -----------------------------------------------------------------------------
+
+void CompactButton_Tick(CompactButton *self, const CompactButtonConfig *config, bool isPressed)
+{
+    switch(GetState(self))
+    {
+        case BUTTON_UP:
+            if(isPressed)
+            {
+                // If the debounce period is zero, we assume that debouncing
+                // is being done via hardware
+                if(config->pressDebouncePeriod == 0)
+                {
+                    Pressed(self, config);
+                }
+                else
+                {
+                    SetState(self, DEBOUNCE_PRESS);
+                    self->counter = 0;
+                }
+            }
+            break;
+        case DEBOUNCE_PRESS:
+            self->counter++;
+            if(self->counter == config->pressDebouncePeriod)
+            {
+                if(isPressed)
+                    Pressed(self, config);
+                else
+                    SetState(self, BUTTON_UP);
+            }
+            break;
+        case BUTTON_DOWN:
+            if(!isPressed)
+            {
+                if(config->releaseDebouncePeriod == 0)
+                {
+                    Released(self, config);
+                }
+                else
+                {
+                    // The long press count is given up for the debounce.
+                    // LONG_REACHED remembers the part that matters.
+                    SetState(self, DEBOUNCE_RELEASE);
+                    self->counter = 0;
+                }
+            }
+            else if(config->longPressPeriod != 0 && !(self->status & LONG_REACHED))
+            {
+                self->counter++;
+                if(self->counter == config->longPressPeriod)
+                    self->status |= LONG_PRESS_FLAG | LONG_REACHED;
+            }
+            break;
+        case DEBOUNCE_RELEASE:
+            self->counter++;
+            if(self->counter == config->releaseDebouncePeriod)
+            {
+                if(!isPressed)
+                {
+                    Released(self, config);
+                }
+                else
+                {
+                    // It was only a bounce. The button is still down, but the
+                    // long press starts counting over.
+                    SetState(self, BUTTON_DOWN);
+                    self->counter = 0;
+                }
+            }
+            break;
+        default:
+
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void CompactButton_TickRow(CompactButton *keys, const CompactButtonConfig *config, uint8_t input, uint8_t numKeys)
+{
+    uint8_t i;
+
+    if(numKeys > 8)
+        numKeys = 8;
+
+    for(i = 0; i < numKeys; i++)
+    {
+        // Nearly every key is up and staying up, so don't bother with the
+        // rest of the tick for those
+        if((input & 1) || GetState(&keys[i]) != BUTTON_UP)
+            CompactButton_Tick(&keys[i], config, input & 1);
+
+        input >>= 1;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool CompactButton_GetShortPress(CompactButton *self)
+{
+    if(self->status & SHORT_PRESS_FLAG)
+        return true;
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool CompactButton_GetLongPress(CompactButton *self)
+{
+    if(self->status & LONG_PRESS_FLAG)
+        return true;
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+void CompactButton_ClearShortPressFlag(CompactButton *self)
+{
+    self->status &= ~SHORT_PRESS_FLAG;
+}
+
+// -----------------------------------------------------------------------------
+
+void CompactButton_ClearLongPressFlag(CompactButton *self)
+{
+    self->status &= ~LONG_PRESS_FLAG;
+}
+
+// -----------------------------------------------------------------------------
+
+bool CompactButton_GetButtonDownEvent(CompactButton *self)
+{
+    if(self->status & BUTTON_DOWN_FLAG)
+        return true;
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool CompactButton_GetButtonUpEvent(CompactButton *self)
+{
+    if(self->status & BUTTON_UP_FLAG)
+        return true;
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+void CompactButton_ClearButtonDownFlag(CompactButton *self)
+{
+    self->status &= ~BUTTON_DOWN_FLAG;
+}
+
+// -----------------------------------------------------------------------------
+
+void CompactButton_ClearButtonUpFlag(CompactButton *self)
+{
+    self->status &= ~BUTTON_UP_FLAG;
+}
+
+// -----------------------------------------------------------------------------
+
+bool CompactButton_NeedsTick(CompactButton *self, const CompactButtonConfig *config)
+{
+    switch(GetState(self))
+    {
+        case DEBOUNCE_PRESS:
+        case DEBOUNCE_RELEASE:
+            return true;
+        case BUTTON_DOWN:
+            // Still timing the long press
+            if(config->longPressPeriod != 0 && !(self->status & LONG_REACHED))
+                return true;
+            else
+                return false;
+        default:
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void Pressed(CompactButton *self, const CompactButtonConfig *config)
+{
+    self->status = (uint8_t)((self->status & ~(STATE_MASK | LONG_REACHED)) | BUTTON_DOWN | BUTTON_DOWN_FLAG);
+    self->counter = 0;
+
+    // Without a long press, we are finished
+    if(config->longPressPeriod == 0)
+        self->status |= SHORT_PRESS_FLAG;
+}
+
+// -----------------------------------------------------------------------------
+
+static void Released(CompactButton *self, const CompactButtonConfig *config)
+{
+    // If the button is a long press type, the short press happens on the
+    // release, as long as it was let go before the long press
+    if(config->longPressPeriod != 0 && !(self->status & LONG_REACHED))
+        self->status |= SHORT_PRESS_FLAG;
+
+    self->status |= BUTTON_UP_FLAG;
+    SetState(self, BUTTON_UP);
+}
+
+/*
+ End of File
+ */
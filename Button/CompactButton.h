@@ -0,0 +1,109 @@
+/* *****************************************************************************
+ * @Summary Compact Button Header File
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File CompactButton.h
+ *
+ * @Description
+ *      The same debouncing and events as Button, but for when you have a lot
+ *      of keys and not a lot of RAM. A Button keeps its own copy of every
+ *      period and a separate counter for everything, which adds up fast on a
+ *      64 key matrix. A CompactButton is two bytes. One holds the state and
+ *      the event flags, and the other is a single counter that gets used for
+ *      the debounce and then for the long press.
+ *
+ *      The periods live in one CompactButtonConfig that every key shares.
+ *      Make it const so that it stays in program memory, and pass it to every
+ *      tick. Because the counter is only 8 bits, every period has to fit in
+ *      255 ticks. With a 10 ms scan that's still a 2.5 second long press.
+ *
+ *          const CompactButtonConfig keyConfig = { TIMEBASE_MS_TO_TICKS(20),
+ *              TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(1000) };
+ *          CompactButton keys[64];
+ *          ...
+ *          CompactButton_InitArray(keys, 64);
+ *          ...
+ *          CompactButton_TickRow(&keys[row * 8], &keyConfig, rowInput, 8);
+ *
+ *      CompactButton_TickRow takes a whole row of the matrix at once, one bit
+ *      per key, and skips over the keys that are up and staying up. There are
+ *      no callbacks, since there's nowhere to keep a function pointer. Poll
+ *      the flags instead. They work the same as the ones in Button.
+ *
+*******************************************************************************/
+
+#ifndef COMPACT_BUTTON_H
+#define	COMPACT_BUTTON_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Button.h"
+
+// ***** Defines ***************************************************************
+
+
+// ***** Global Variables ******************************************************
+
+typedef struct CompactButton CompactButton;
+typedef struct CompactButtonConfig CompactButtonConfig;
+
+/* One of these is shared by every key that acts the same. A long press period
+ * of zero makes them short press buttons. */
+struct CompactButtonConfig
+{
+    uint8_t pressDebouncePeriod;
+    uint8_t releaseDebouncePeriod;
+    uint8_t longPressPeriod;
+};
+
+struct CompactButton
+{
+    uint8_t status;
+    uint8_t counter;
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * status   The lowest two bits are the ButtonState. The rest are the event
+ *          flags and whether the long press was reached.
+ *
+ * counter  Counts the debounce while debouncing, and the long press while the
+ *          button is down
+ *
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void CompactButton_Init(CompactButton *self);
+
+void CompactButton_InitArray(CompactButton *keys, uint8_t numKeys);
+
+void CompactButton_Tick(CompactButton *self, const CompactButtonConfig *config, bool isPressed);
+
+void CompactButton_TickRow(CompactButton *keys, const CompactButtonConfig *config, uint8_t input, uint8_t numKeys);
+
+bool CompactButton_GetShortPress(CompactButton *self);
+
+bool CompactButton_GetLongPress(CompactButton *self);
+
+void CompactButton_ClearShortPressFlag(CompactButton *self);
+
+void CompactButton_ClearLongPressFlag(CompactButton *self);
+
+bool CompactButton_GetButtonDownEvent(CompactButton *self);
+
+bool CompactButton_GetButtonUpEvent(CompactButton *self);
+
+void CompactButton_ClearButtonDownFlag(CompactButton *self);
+
+void CompactButton_ClearButtonUpFlag(CompactButton *self);
+
+bool CompactButton_NeedsTick(CompactButton *self, const CompactButtonConfig *config);
+
+#endif	/* COMPACT_BUTTON_H */
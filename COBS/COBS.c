@@ -0,0 +1,317 @@
+/*******************************************************************************
+ * @Summary COBS Framing
+ *
+ * @author Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File COBS.c
+ *
+ * @Description
+ *      Every frame is sent as a list of blocks. Each block starts with a code
+ *      byte that says how far it is to the next code byte. Every block except
+ *      the last one stands for a run of data followed by a zero. A code of 
+ *      0xFF means 254 bytes with no zero after them. Since there are no zeros
+ *      left, a zero marks the end of the frame.
+ *
+ * ****************************************************************************/
+
+#include <string.h>
+#include "COBS.h"
+
+// ***** Defines ***************************************************************
+
+// The longest run of data one code byte can cover
+#define MAX_RUN     254
+
+// ***** Function Prototypes ***************************************************
+
+static void AddToFrame(COBSDecoder *self, const uint8_t *data, BufferIndex length);
+
+// ***** Global Variables ******************************************************
+
+static const uint8_t zeroByte = 0;
+
+/*******************************************************************************
+ * Encodes a frame and puts it in a Buffer
+ * <p>
+ * Each run of bytes between zeros is found with memchr and copied into the 
+ * buffer in one piece with Buffer_Write. The zero that marks the end of the 
+ * frame is added for you. Nothing is written unless there is room for the 
+ * whole frame.
+ *
+ * @param out  pointer to the Buffer to put the frame in
+ *
+ * @param data  pointer to the data to send
+ *
+ * @param length  the number of bytes to send
+ *
+ * @return true if the frame was put in the buffer
+ */
+bool COBS_EncodeFrame(Buffer *out, const uint8_t *data, BufferIndex length)
+{
+    BufferIndex space = Buffer_GetSpace(out);
+    BufferIndex run;
+    const uint8_t *zero;
+    
+    // Check it in two steps so that the max size can't roll over
+    if(length > space || space - length < length / MAX_RUN + 2)
+        return false;
+    
+    while(1)
+    {
+        run = length < MAX_RUN ? length : MAX_RUN;
+        zero = (const uint8_t *)memchr(data, 0, run);
+        
+        if(zero)
+            run = (BufferIndex)(zero - data);
+        
+        Buffer_WriteChar(out, (uint8_t)(run + 1));
+        Buffer_Write(out, data, run);
+        data += run;
+        length -= run;
+        
+        if(zero)
+        {
+            // The zero is the code byte. There is always another block after
+            // it, even if it's empty.
+            data++;
+            length--;
+        }
+        else if(length == 0)
+        {
+            break;
+        }
+    }
+    
+    Buffer_WriteChar(out, 0);
+    return true;
+}
+
+/*******************************************************************************
+ * Encodes a frame into an array
+ * <p>
+ * Goes one byte at a time, which is quicker than COBS_EncodeFrame for short 
+ * frames with lots of zeros in them. Each zero would be another trip into 
+ * the Buffer otherwise. Once it's encoded, put the whole thing in your 
+ * buffer with one Buffer_Write. The zero that marks the end of the frame is
+ * added for you.
+ *
+ * @param out  pointer to an array of at least COBS_MAX_ENCODED_SIZE(length)
+ *
+ * @param data  pointer to the data to send
+ *
+ * @param length  the number of bytes to send
+ *
+ * @return the number of bytes put in the array
+ */
+BufferIndex COBS_Encode(uint8_t *out, const uint8_t *data, BufferIndex length)
+{
+    uint8_t *code = out;
+    uint8_t *next = out + 1;
+    uint8_t run = 1;
+    
+    while(length != 0)
+    {
+        length--;
+        
+        if(*data == 0)
+        {
+            // The zero turns into the code byte for this block
+            *code = run;
+            code = next++;
+            run = 1;
+        }
+        else
+        {
+            *next++ = *data;
+            run++;
+            
+            // A full block doesn't have a zero after it. Only start another 
+            // one if there's more to come, the same as COBS_EncodeFrame.
+            if(run == MAX_RUN + 1 && length != 0)
+            {
+                *code = run;
+                code = next++;
+                run = 1;
+            }
+        }
+        data++;
+    }
+    
+    *code = run;
+    *next++ = 0;
+    return (BufferIndex)(next - out);
+}
+
+/*******************************************************************************
+ * Initializes a COBSDecoder object
+ *
+ * @param self  pointer to the COBSDecoder that you are going to use
+ *
+ * @param frame  pointer to the array to put the decoded frames in
+ *
+ * @param frameSize  the size of said array. Longer frames get thrown away.
+ *
+ * @return none
+ */
+void COBS_InitDecoder(COBSDecoder *self, uint8_t *frame, BufferIndex frameSize)
+{
+    self->private.frame = frame;
+    self->private.frameSize = frameSize;
+    self->frameDropped = false;
+    COBS_ResetDecoder(self);
+}
+
+/*******************************************************************************
+ * Decodes data from a Buffer until a frame is finished or the buffer is empty
+ * <p>
+ * The data is decoded right out of the buffer with Buffer_PeekContiguous. 
+ * Data bytes are copied into your frame a whole block at a time. Whatever is 
+ * used up is removed from the buffer. If the frame isn't done yet, the part 
+ * that was decoded is kept for next time.
+ * <p>
+ * The frame stays in your array until the next call. Use it or copy it 
+ * before then.
+ *
+ * @param self  pointer to the COBSDecoder that you are using
+ *
+ * @param in  pointer to the Buffer to take the data from
+ *
+ * @return the length of the frame if one was finished, or zero if not
+ */
+BufferIndex COBS_Decode(COBSDecoder *self, Buffer *in)
+{
+    uint8_t *data;
+    BufferIndex available, used, n, length;
+    const uint8_t *zero;
+    uint8_t code;
+    
+    while((available = Buffer_PeekContiguous(in, &data)) != 0)
+    {
+        used = 0;
+        
+        while(used < available)
+        {
+            if(self->private.remaining != 0)
+            {
+                // Copy as much of the block as we have, up to any zero
+                n = available - used;
+                if(n > self->private.remaining)
+                    n = self->private.remaining;
+                
+                zero = (const uint8_t *)memchr(&data[used], 0, n);
+                
+                if(zero)
+                {
+                    // The frame ended in the middle of a block. The sender 
+                    // must have been cut off. Start over from here.
+                    used += (BufferIndex)(zero - &data[used]) + 1;
+                    self->frameDropped = true;
+                    COBS_ResetDecoder(self);
+                    continue;
+                }
+                
+                AddToFrame(self, &data[used], n);
+                used += n;
+                self->private.remaining -= (uint8_t)n;
+                continue;
+            }
+            
+            code = data[used++];
+            
+            if(code == 0)
+            {
+                // End of the frame
+                length = self->private.length;
+                
+                if(self->private.discard)
+                    self->frameDropped = true;
+                
+                if(self->private.inFrame && !self->private.discard && length != 0)
+                {
+                    Buffer_CommitRead(in, used);
+                    COBS_ResetDecoder(self);
+                    return length;
+                }
+                
+                // Empty or broken frames are skipped
+                COBS_ResetDecoder(self);
+            }
+            else
+            {
+                if(self->private.zeroPending)
+                {
+                    AddToFrame(self, &zeroByte, 1);
+                }
+                self->private.remaining = code - 1;
+                self->private.zeroPending = (code != 0xFF);
+                self->private.inFrame = true;
+            }
+        }
+        Buffer_CommitRead(in, used);
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Throws away the part of a frame that has been decoded so far
+ * <p>
+ * The decoder will wait for the next zero before it starts a new frame. Use 
+ * this if you know the stream was broken, like after a UART error.
+ *
+ * @param self  pointer to the COBSDecoder that you are using
+ *
+ * @return none
+ */
+void COBS_ResetDecoder(COBSDecoder *self)
+{
+    self->private.length = 0;
+    self->private.remaining = 0;
+    self->private.zeroPending = false;
+    self->private.inFrame = false;
+    self->private.discard = false;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if a frame was thrown away
+ *
+ * The flag is cleared when you call this function.
+ *
+ * @param self  pointer to the COBSDecoder that you are using
+ *
+ * @return true if a frame was too long or was cut off
+ */
+bool COBS_DidDropFrame(COBSDecoder *self)
+{
+    // Automatically clear the flag
+    bool temp = self->frameDropped;
+    self->frameDropped = false;
+    return temp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void AddToFrame(COBSDecoder *self, const uint8_t *data, BufferIndex length)
+{
+    if(self->private.discard)
+        return;
+    
+    if(length > self->private.frameSize - self->private.length)
+    {
+        // It won't fit. Throw the rest of the frame away.
+        self->private.discard = true;
+        return;
+    }
+    
+    memcpy(&self->private.frame[self->private.length], data, length);
+    self->private.length += length;
+}
+
+/*
+ End of File
+ */
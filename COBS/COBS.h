@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * @Summary COBS Framing Header
+ *
+ * @author Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File COBS.h
+ *
+ * @Description
+ *      Consistent Overhead Byte Stuffing. Splits a stream of bytes into 
+ *      frames by getting rid of every zero in the data, so that a zero can 
+ *      mark the end of every frame. It only ever adds one byte for every 254 
+ *      bytes of data, plus the zero at the end, no matter what the data is.
+ *      If a byte gets lost, the receiver just waits for the next zero and 
+ *      picks right back up.
+ *
+ *      The encoder puts a whole frame straight into a Buffer, like your 
+ *      transmit buffer. The data is copied in blocks, one for every run of 
+ *      bytes between zeros. A frame is only written if the whole thing fits, 
+ *      so the other end never gets half of one. Once it's in there, start 
+ *      your transmitter like you normally would.
+ *
+ *          COBS_EncodeFrame(&txBuffer, packet, sizeof(packet));
+ *
+ *      Short frames with lots of zeros in them are quicker to encode into an
+ *      array with COBS_Encode first, then write to the buffer all at once.
+ *
+ *      The decoder takes bytes out of a Buffer, like your receive buffer, and
+ *      puts the decoded frame in an array that you give it. It reads the
+ *      buffer in place, so there's no copy in between. You can call it 
+ *      whenever you like. If only part of a frame has arrived, it keeps what 
+ *      it has and picks up where it left off next time. It stops as soon as 
+ *      a frame is finished, so you can use the frame before the next one 
+ *      starts coming in.
+ *
+ *          COBSDecoder decoder;
+ *          uint8_t frame[64];
+ *          BufferIndex length;
+ * 
+ *          COBS_InitDecoder(&decoder, frame, sizeof(frame));
+ *          ...
+ *          while((length = COBS_Decode(&decoder, &rxBuffer)) != 0)
+ *              HandlePacket(frame, length);
+ *
+ *      Frames that are too big for your array, or that were cut off by a 
+ *      zero in the wrong place, are thrown away. COBS_DidDropFrame tells you 
+ *      if that happened. Empty frames are skipped, so you can send an extra 
+ *      zero before a frame to make sure the receiver is lined up.
+ *
+ * ****************************************************************************/
+
+#ifndef COBS_H
+#define	COBS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Buffer.h"
+
+// ***** Defines ***************************************************************
+
+/*  The most bytes a frame of length n can turn into, including the zero at 
+    the end. Use this to size your transmit buffer. */
+#define COBS_MAX_ENCODED_SIZE(n)    ((n) + (n) / 254 + 2)
+
+// ***** Global Variables ******************************************************
+
+typedef struct COBSDecoder COBSDecoder;
+
+struct COBSDecoder
+{
+    volatile bool frameDropped;
+    
+    struct
+    {
+        uint8_t *frame;
+        BufferIndex frameSize;
+        BufferIndex length;
+        uint8_t remaining;
+        bool zeroPending;
+        bool inFrame;
+        bool discard;
+    } private;
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * frame        The array that the decoded frame goes into
+ *
+ * frameSize    The size of the array
+ *
+ * length       How much of the frame has been decoded so far
+ *
+ * remaining    How many data bytes are left before the next code byte
+ *
+ * zeroPending  The block we just finished ended in a zero. It gets added 
+ *              when the next block starts. The last one is never added.
+ *
+ * inFrame      At least one code byte has come in for this frame. 
+ *
+ * discard      Something went wrong with this frame. Throw the rest of it
+ *              away until the next zero.
+ */
+
+// ***** Function Prototypes ***************************************************
+
+bool COBS_EncodeFrame(Buffer *out, const uint8_t *data, BufferIndex length);
+
+BufferIndex COBS_Encode(uint8_t *out, const uint8_t *data, BufferIndex length);
+
+void COBS_InitDecoder(COBSDecoder *self, uint8_t *frame, BufferIndex frameSize);
+
+BufferIndex COBS_Decode(COBSDecoder *self, Buffer *in);
+
+void COBS_ResetDecoder(COBSDecoder *self);
+
+bool COBS_DidDropFrame(COBSDecoder *self);
+
+#endif	/* COBS_H */
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * @Summary CRC Header
+ *
+ * @author Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File CRC.h
+ *
+ * @Description
+ *      Streaming CRC16 and CRC32. You start with the initial value, feed it
+ *      the data in as many pieces as you like, and the result is the same as
+ *      if you had given it everything at once. That means it works with the
+ *      block functions in Buffer, where the data comes in at most two pieces,
+ *      and with data that trickles in a byte at a time.
+ *
+ *          uint16_t crc = CRC16_INITIAL;
+ *          crc = CRC16_Update(crc, header, sizeof(header));
+ *          crc = CRC16_Update(crc, payload, length);
+ *
+ *      The CRC16 is the CCITT one with a polynomial of 0x1021, starting at
+ *      0xFFFF, with nothing flipped. The CRC of "123456789" is 0x29B1. The
+ *      CRC32 is the one from Ethernet and zip files. It has to be finished
+ *      with CRC32_FINAL, and the CRC of "123456789" is 0xCBF43926.
+ *
+ *      Both of them use a lookup table so that each byte is only a couple of
+ *      operations instead of eight shifts. The tables are const, so they stay
+ *      in program memory, but they are 512 bytes for the CRC16 and 1K for the
+ *      CRC32. If that's too much for your part, define CRC_SMALL_TABLES for
+ *      your whole project. The tables are only 16 entries each, and every
+ *      byte is done as two halves instead. It's around half as fast.
+ *
+ *      If you define BUFFER_ENABLE_CRC, Buffer can also work out the CRC of
+ *      whatever is stored in it without taking it out, and keep a running
+ *      CRC of everything that gets written to it. See Buffer.h.
+ *
+ * ****************************************************************************/
+
+#ifndef CRC_H
+#define	CRC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+#define CRC16_INITIAL       0xFFFF
+#define CRC32_INITIAL       0xFFFFFFFFUL
+
+// The CRC32 is flipped once at the very end
+#define CRC32_FINAL(crc)    ((uint32_t)~(crc))
+
+// ***** Global Variables ******************************************************
+
+
+// ***** Function Prototypes ***************************************************
+
+uint16_t CRC16_UpdateChar(uint16_t crc, uint8_t data);
+
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint32_t length);
+
+uint32_t CRC32_UpdateChar(uint32_t crc, uint8_t data);
+
+uint32_t CRC32_Update(uint32_t crc, const uint8_t *data, uint32_t length);
+
+#endif	/* CRC_H */
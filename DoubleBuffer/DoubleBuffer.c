@@ -0,0 +1,203 @@
+/* *****************************************************************************
+ * @Summary Double Buffer
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File DoubleBuffer.c
+ *
+ * @Description
+ *      The blocks go around in a circle. The ready blocks are the numReady
+ *      blocks starting at readyIndex, and the fill block is always the one
+ *      right after them. The filling side only ever moves the fill block, and
+ *      the processing side only ever moves readyIndex. The count they share
+ *      is the only thing that needs protecting.
+ *
+*******************************************************************************/
+
+#include "DoubleBuffer.h"
+
+// ***** Defines ***************************************************************
+
+/*  A block could finish in an interrupt right while we are releasing one.
+    These save whether the interrupts were on, so they're safe to use from an
+    interrupt too. */
+#ifndef DOUBLE_BUFFER_ENTER_CRITICAL
+    #if defined(__XC8)
+        #include <xc.h>
+        #define DOUBLE_BUFFER_ENTER_CRITICAL(state)     do { (state) = INTCONbits.GIE; di(); } while(0)
+        #define DOUBLE_BUFFER_EXIT_CRITICAL(state)      do { if(state) ei(); } while(0)
+    #else
+        #define DOUBLE_BUFFER_ENTER_CRITICAL(state)     ((state) = 0)
+        #define DOUBLE_BUFFER_EXIT_CRITICAL(state)      ((void)(state))
+    #endif
+#endif
+
+// ***** Function Prototypes ***************************************************
+
+
+// ***** Global Variables ******************************************************
+
+
+// ----- Initialize ------------------------------------------------------------
+
+void DoubleBuffer_Init(DoubleBuffer *self, uint8_t *memory, uint16_t blockSize, uint8_t numBlocks)
+{
+    // It takes at least two to swap
+    if(numBlocks < 2)
+        numBlocks = 2;
+
+    self->private.memory = memory;
+    self->private.blockSize = blockSize;
+    self->private.numBlocks = numBlocks;
+    self->private.fillBlock = memory;
+    self->private.fillCount = 0;
+    self->private.fillIndex = 0;
+    self->private.readyIndex = 0;
+    self->private.numReady = 0;
+    self->private.overrun = false;
+    self->private.blockCompleteCallbackFunc = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+bool DoubleBuffer_WriteChar(DoubleBuffer *self, uint8_t data)
+{
+    self->private.fillBlock[self->private.fillCount] = data;
+    self->private.fillCount++;
+
+    if(self->private.fillCount == self->private.blockSize)
+        return DoubleBuffer_BlockComplete(self);
+    else
+        return true;
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t *DoubleBuffer_GetFillBlock(DoubleBuffer *self)
+{
+    return self->private.fillBlock;
+}
+
+// -----------------------------------------------------------------------------
+
+bool DoubleBuffer_BlockComplete(DoubleBuffer *self)
+{
+    uint8_t interruptState;
+    bool swapped = false;
+
+    self->private.fillCount = 0;
+
+    DOUBLE_BUFFER_ENTER_CRITICAL(interruptState);
+
+    // One block always has to be left over to fill
+    if(self->private.numReady < self->private.numBlocks - 1)
+    {
+        self->private.numReady++;
+        swapped = true;
+    }
+    DOUBLE_BUFFER_EXIT_CRITICAL(interruptState);
+
+    if(swapped)
+    {
+        self->private.fillIndex++;
+
+        if(self->private.fillIndex == self->private.numBlocks)
+            self->private.fillIndex = 0;
+
+        self->private.fillBlock = self->private.memory +
+            (uint32_t)self->private.fillIndex * self->private.blockSize;
+
+        if(self->private.blockCompleteCallbackFunc)
+        {
+            self->private.blockCompleteCallbackFunc(self);
+        }
+    }
+    else
+    {
+        // Nowhere to go. Fill the same one over again.
+        self->private.overrun = true;
+    }
+    return swapped;
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t *DoubleBuffer_GetReadyBlock(DoubleBuffer *self)
+{
+    // Zero means there's nothing to process yet
+    if(self->private.numReady == 0)
+        return 0;
+    else
+        return self->private.memory +
+            (uint32_t)self->private.readyIndex * self->private.blockSize;
+}
+
+// -----------------------------------------------------------------------------
+
+void DoubleBuffer_ReleaseBlock(DoubleBuffer *self)
+{
+    uint8_t interruptState;
+
+    if(self->private.numReady == 0)
+        return;
+
+    self->private.readyIndex++;
+
+    if(self->private.readyIndex == self->private.numBlocks)
+        self->private.readyIndex = 0;
+
+    DOUBLE_BUFFER_ENTER_CRITICAL(interruptState);
+    self->private.numReady--;
+    DOUBLE_BUFFER_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+bool DoubleBuffer_IsReady(DoubleBuffer *self)
+{
+    if(self->private.numReady != 0)
+        return true;
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t DoubleBuffer_GetReadyCount(DoubleBuffer *self)
+{
+    return self->private.numReady;
+}
+
+// -----------------------------------------------------------------------------
+
+bool DoubleBuffer_DidOverrun(DoubleBuffer *self)
+{
+    // Clear on read
+    if(self->private.overrun)
+    {
+        self->private.overrun = false;
+        return true;
+    }
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t DoubleBuffer_GetBlockSize(DoubleBuffer *self)
+{
+    return self->private.blockSize;
+}
+
+// -----------------------------------------------------------------------------
+
+void DoubleBuffer_SetBlockCompleteCallback(DoubleBuffer *self, DoubleBufferCallbackFunc Function)
+{
+    self->private.blockCompleteCallbackFunc = Function;
+}
+
+/*
+ End of File
+ */
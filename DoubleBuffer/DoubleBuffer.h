@@ -0,0 +1,126 @@
+/* *****************************************************************************
+ * @Summary Double Buffer Header File
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File DoubleBuffer.h
+ *
+ * @Description
+ *      For data that comes in whole blocks at a time, like ADC samples or
+ *      audio. The memory is split into two or more blocks that are all the
+ *      same size. One of them is always being filled. When it's full, it is
+ *      handed over to be processed and the next block starts filling. Your
+ *      processing gets a pointer to a whole block and works on it right
+ *      where it is, without any of the per byte bookkeeping of a Buffer.
+ *
+ *      The filling side can be an interrupt that writes one sample at a time
+ *      with DoubleBuffer_WriteChar, or a DMA. For a DMA, point it at
+ *      DoubleBuffer_GetFillBlock and call DoubleBuffer_BlockComplete from the
+ *      DMA complete interrupt, then point it at the new fill block.
+ *
+ *          uint8_t adcMemory[2 * 64];
+ *          DoubleBuffer adcBlocks;
+ *          DoubleBuffer_Init(&adcBlocks, adcMemory, 64, 2);
+ *          ...
+ *          block = DoubleBuffer_GetReadyBlock(&adcBlocks);
+ *          if(block)
+ *          {
+ *              Process(block);
+ *              DoubleBuffer_ReleaseBlock(&adcBlocks);
+ *          }
+ *
+ *      The blocks can go straight out with UART_Send, or with the UART DMA if
+ *      you give each ready block to the transmit buffer.
+ *
+ *      If every other block is still waiting to be processed when the fill
+ *      block is finished, there's nowhere to go. The block that just filled
+ *      gets filled again, its data is lost, and the overrun flag is set. A
+ *      block isn't free again until you release it. With more blocks, the
+ *      processing can fall further behind before that happens.
+ *
+ *      The block complete callback is called from whatever finished the
+ *      block, which is usually an interrupt. Keep it short, like setting a
+ *      Scheduler task ready.
+ *
+*******************************************************************************/
+
+#ifndef DOUBLE_BUFFER_H
+#define	DOUBLE_BUFFER_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+
+// ***** Global Variables ******************************************************
+
+typedef struct DoubleBuffer DoubleBuffer;
+
+/*  callback function pointer. The context is so that you can know which
+    buffer initiated the callback. This is so that you can service multiple
+    buffer callbacks with the same function if you desire. */
+typedef void (*DoubleBufferCallbackFunc)(DoubleBuffer *bufferContext);
+
+struct DoubleBuffer
+{
+    struct
+    {
+        uint8_t *memory;
+        uint8_t *fillBlock;
+        uint16_t blockSize;
+        uint8_t numBlocks;
+        volatile uint16_t fillCount;
+        volatile uint8_t fillIndex;
+        volatile uint8_t readyIndex;
+        volatile uint8_t numReady;
+        volatile bool overrun;
+        DoubleBufferCallbackFunc blockCompleteCallbackFunc;
+    } private;
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * fillBlock    The block being filled right now, and which one it is
+ * fillIndex
+ *
+ * fillCount    How many bytes WriteChar has put in the fill block
+ *
+ * readyIndex   The oldest block waiting to be processed. The ones after it are
+ *              the next to be processed, then the fill block.
+ *
+ * numReady     How many blocks are waiting or being processed
+ *
+ * overrun      A full block had to be filled again before it was processed
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void DoubleBuffer_Init(DoubleBuffer *self, uint8_t *memory, uint16_t blockSize, uint8_t numBlocks);
+
+bool DoubleBuffer_WriteChar(DoubleBuffer *self, uint8_t data);
+
+uint8_t *DoubleBuffer_GetFillBlock(DoubleBuffer *self);
+
+bool DoubleBuffer_BlockComplete(DoubleBuffer *self);
+
+uint8_t *DoubleBuffer_GetReadyBlock(DoubleBuffer *self);
+
+void DoubleBuffer_ReleaseBlock(DoubleBuffer *self);
+
+bool DoubleBuffer_IsReady(DoubleBuffer *self);
+
+uint8_t DoubleBuffer_GetReadyCount(DoubleBuffer *self);
+
+bool DoubleBuffer_DidOverrun(DoubleBuffer *self);
+
+uint16_t DoubleBuffer_GetBlockSize(DoubleBuffer *self);
+
+void DoubleBuffer_SetBlockCompleteCallback(DoubleBuffer *self, DoubleBufferCallbackFunc Function);
+
+#endif	/* DOUBLE_BUFFER_H */
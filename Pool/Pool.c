@@ -0,0 +1,184 @@
+/* *****************************************************************************
+ * @Summary Fixed Block Memory Pool
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Pool.c
+ * 
+ * @Description
+ *      The free blocks are a stack. Getting a block takes the one on top and 
+ *      giving one back puts it on top, so both are only a couple of pointer 
+ *      moves. The only loop is in Pool_Init, which links all of the blocks 
+ *      together once.
+ * 
+*******************************************************************************/
+
+#include <stddef.h>
+#include "Pool.h"
+
+// ***** Defines ***************************************************************
+
+/*  An interrupt could get or give back a block right in the middle of us 
+    doing the same thing. These save whether the interrupts were on, so it's 
+    safe to use the pool from an interrupt too. */
+#ifndef POOL_ENTER_CRITICAL
+    #if defined(__XC8)
+        #include <xc.h>
+        #define POOL_ENTER_CRITICAL(state)      do { (state) = INTCONbits.GIE; di(); } while(0)
+        #define POOL_EXIT_CRITICAL(state)       do { if(state) ei(); } while(0)
+    #else
+        #define POOL_ENTER_CRITICAL(state)      ((state) = 0)
+        #define POOL_EXIT_CRITICAL(state)       ((void)(state))
+    #endif
+#endif
+
+/*  Define POOL_CHECK_DOUBLE_FREE to also look through the free list on every
+    Pool_Free, so that a block that was given back twice gets caught even when
+    other blocks are still out. It takes longer the more free blocks there 
+    are, and the interrupts stay off the whole time, so it's off by default. */
+#ifndef POOL_CHECK_DOUBLE_FREE
+    #define IsOnFreeList(self, block)   false
+#endif
+
+// ***** Function Prototypes ***************************************************
+
+#ifdef POOL_CHECK_DOUBLE_FREE
+static bool IsOnFreeList(Pool *self, void *block);
+#endif
+
+// ***** Global Variables ******************************************************
+
+
+// ----- Initialize ------------------------------------------------------------
+
+void Pool_Init(Pool *self, void *memory, uint16_t blockSize, uint16_t numBlocks)
+{
+    uint8_t *block = (uint8_t *)memory;
+    uint16_t i;
+    
+    // Every block has to be able to hold the link to the next one
+    blockSize = POOL_BLOCK_SIZE(blockSize);
+    
+    self->private.blockSize = blockSize;
+    self->private.numBlocks = numBlocks;
+    self->private.start = block;
+    self->private.end = block + (uint32_t)blockSize * numBlocks;
+    self->private.freeList = 0;
+    
+    // Link them from the back so that the first block comes out first
+    for(i = numBlocks; i > 0; i--)
+    {
+        block = self->private.start + (uint32_t)blockSize * (i - 1);
+        *(void **)block = self->private.freeList;
+        self->private.freeList = block;
+    }
+    
+    self->private.numFree = numBlocks;
+    self->private.minFree = numBlocks;
+}
+
+// -----------------------------------------------------------------------------
+
+void *Pool_Alloc(Pool *self)
+{
+    uint8_t interruptState;
+    void *block;
+    
+    POOL_ENTER_CRITICAL(interruptState);
+    block = self->private.freeList;
+    
+    if(block)
+    {
+        self->private.freeList = *(void **)block;
+        self->private.numFree--;
+        
+        if(self->private.numFree < self->private.minFree)
+            self->private.minFree = self->private.numFree;
+    }
+    POOL_EXIT_CRITICAL(interruptState);
+    
+    // Zero means they're all in use
+    return block;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Pool_Free(Pool *self, void *block)
+{
+    uint8_t interruptState;
+    
+    // Don't let something that isn't ours into the list. It has to be in the
+    // array and at the start of a block.
+    if((uint8_t *)block < self->private.start || (uint8_t *)block >= self->private.end)
+        return false;
+    
+    // The offset fits in a size_t, since it's inside the array. On a PIC that
+    // keeps it a 16-bit divide instead of a 32-bit one.
+    if((size_t)((uint8_t *)block - self->private.start) % self->private.blockSize != 0)
+        return false;
+    
+    POOL_ENTER_CRITICAL(interruptState);
+    
+    // If they're all free already, this one was given back twice
+    if(self->private.numFree == self->private.numBlocks || IsOnFreeList(self, block))
+    {
+        POOL_EXIT_CRITICAL(interruptState);
+        return false;
+    }
+    
+    *(void **)block = self->private.freeList;
+    self->private.freeList = block;
+    self->private.numFree++;
+    POOL_EXIT_CRITICAL(interruptState);
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t Pool_GetFreeCount(Pool *self)
+{
+    return self->private.numFree;
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t Pool_GetMinFreeCount(Pool *self)
+{
+    return self->private.minFree;
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t Pool_GetBlockSize(Pool *self)
+{
+    return self->private.blockSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef POOL_CHECK_DOUBLE_FREE
+static bool IsOnFreeList(Pool *self, void *block)
+{
+    void *free = self->private.freeList;
+    
+    while(free)
+    {
+        if(free == block)
+            return true;
+        
+        free = *(void **)free;
+    }
+    return false;
+}
+#endif
+
+/*
+ End of File
+ */
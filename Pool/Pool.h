@@ -0,0 +1,112 @@
+/* *****************************************************************************
+ * @Summary Fixed Block Memory Pool Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Pool.h
+ * 
+ * @Description
+ *      A pile of blocks that are all the same size, for when you need memory 
+ *      for a frame or a message but don't have a heap. Getting a block and 
+ *      giving one back always take the same short amount of time, no matter 
+ *      how many blocks there are, and both are safe to do from an interrupt.
+ * 
+ *      The idea is to stop copying frames around. Instead of reading a frame 
+ *      into an array on the stack and then copying it again into a transmit 
+ *      buffer, the receiver gets a block, fills it, and pushes the pointer 
+ *      into a Queue made with Queue_InitPointers. The handler pops the 
+ *      pointer, works on the frame right where it is, and either passes it on
+ *      the same way or gives it back with Pool_Free. Only the pointer ever 
+ *      moves. Whoever has the pointer owns the block.
+ * 
+ *      The free blocks are kept in a list that uses the blocks themselves to 
+ *      hold the links, so the pool doesn't need any memory of its own. That 
+ *      means every block has to be big enough for a pointer and lined up 
+ *      like one. Use POOL_DECLARE to make the array and it's taken care of:
+ * 
+ *          POOL_DECLARE(frameMemory, FRAME_SIZE, 8);
+ *          Pool framePool;
+ *          Pool_Init(&framePool, frameMemory, FRAME_SIZE, 8);
+ * 
+ *      Pool_Free won't take a pointer that isn't the start of one of its own
+ *      blocks, or a block when all of them are already free, and it returns 
+ *      false instead. Define POOL_CHECK_DOUBLE_FREE to also catch a block 
+ *      that's given back twice while others are still out.
+ * 
+ *      The free list is shared by everyone who uses the pool, so it is 
+ *      protected by POOL_ENTER_CRITICAL and POOL_EXIT_CRITICAL. With XC8, 
+ *      these turn the interrupts off and on. Anywhere else you'll need to 
+ *      define them yourself if an interrupt uses the pool.
+ * 
+*******************************************************************************/
+
+#ifndef POOL_H
+#define	POOL_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+/*  The size of one block after it has been rounded up to a whole number of 
+    pointers */
+#define POOL_BLOCK_WORDS(size)      (((size) + sizeof(void *) - 1) / sizeof(void *))
+#define POOL_BLOCK_SIZE(size)       (POOL_BLOCK_WORDS(size) * sizeof(void *))
+
+// Makes an array that is big enough and lined up right for the pool
+#define POOL_DECLARE(name, blockSize, numBlocks)    void *name[POOL_BLOCK_WORDS(blockSize) * (numBlocks)]
+
+// ***** Global Variables ******************************************************
+
+typedef struct Pool Pool;
+
+struct Pool
+{
+    struct
+    {
+        void *freeList;
+        uint8_t *start;
+        uint8_t *end;
+        uint16_t blockSize;
+        uint16_t numBlocks;
+        volatile uint16_t numFree;
+        uint16_t minFree;
+    } private;
+};
+
+/* These variable should be treated as private. You should only access them   
+ * with the use of a function.
+ * 
+ * freeList     The first free block. The first few bytes of every free block 
+ *              point to the next one.
+ * 
+ * start        Where the blocks start and end, so we can tell if something 
+ * end          given back actually came from this pool
+ * 
+ * blockSize    The size of each block after rounding it up
+ * 
+ * numFree      How many blocks are left
+ * 
+ * minFree      The fewest blocks that have ever been left. If this gets to 
+ *              zero, you need more blocks.
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void Pool_Init(Pool *self, void *memory, uint16_t blockSize, uint16_t numBlocks);
+
+void *Pool_Alloc(Pool *self);
+
+bool Pool_Free(Pool *self, void *block);
+
+uint16_t Pool_GetFreeCount(Pool *self);
+
+uint16_t Pool_GetMinFreeCount(Pool *self);
+
+uint16_t Pool_GetBlockSize(Pool *self);
+
+#endif	/* POOL_H */
@@ -0,0 +1,159 @@
+/* *****************************************************************************
+ * @Summary Profiling
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Profile.c
+ * 
+ * @Description
+ *      Keeps the stats for every profile point. Recording is kept as short as 
+ *      possible since it runs inside of interrupts. All of the slow stuff, 
+ *      like the divide for the average and the text conversion, only happens 
+ *      when you ask for a report.
+ * 
+*******************************************************************************/
+
+#include "Profile.h"
+
+// ***** Defines ***************************************************************
+
+/*  The same point can be recorded from main and from an interrupt, like 
+    Buffer_WriteChar for the transmit and the receive buffers. The counters 
+    are too big to update in one instruction, so the update can't be split 
+    up. These save whether the interrupts were on, so it's safe to record 
+    from inside an interrupt too. */
+#ifndef PROFILE_ENTER_CRITICAL
+    #if defined(__XC8)
+        #include <xc.h>
+        #define PROFILE_ENTER_CRITICAL(state)   do { (state) = INTCONbits.GIE; di(); } while(0)
+        #define PROFILE_EXIT_CRITICAL(state)    do { if(state) ei(); } while(0)
+    #else
+        #define PROFILE_ENTER_CRITICAL(state)   ((state) = 0)
+        #define PROFILE_EXIT_CRITICAL(state)    ((void)(state))
+    #endif
+#endif
+
+// ***** Function Prototypes ***************************************************
+
+static char *AppendText(char *line, const char *text);
+static char *AppendNumber(char *line, uint32_t number);
+
+// ***** Global Variables ******************************************************
+
+static ProfileStats stats[PROFILE_NUM_POINTS];
+
+// -----------------------------------------------------------------------------
+
+void Profile_Record(ProfilePoint point, ProfileCycles cycles)
+{
+    ProfileStats *s = &stats[point];
+    uint8_t interruptState;
+    
+    PROFILE_ENTER_CRITICAL(interruptState);
+    s->calls++;
+    s->totalCycles += cycles;
+    
+    // The first time through, there is no min yet
+    if(cycles < s->minCycles || s->calls == 1)
+        s->minCycles = cycles;
+    
+    if(cycles > s->maxCycles)
+        s->maxCycles = cycles;
+    
+    PROFILE_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+void Profile_GetStats(ProfilePoint point, ProfileStats *statsOut)
+{
+    uint8_t interruptState;
+    
+    // So we don't get half of an update
+    PROFILE_ENTER_CRITICAL(interruptState);
+    *statsOut = stats[point];
+    PROFILE_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+void Profile_Reset(void)
+{
+    uint8_t interruptState;
+    uint8_t i;
+    
+    for(i = 0; i < PROFILE_NUM_POINTS; i++)
+    {
+        PROFILE_ENTER_CRITICAL(interruptState);
+        stats[i].calls = 0;
+        stats[i].totalCycles = 0;
+        stats[i].minCycles = 0;
+        stats[i].maxCycles = 0;
+        PROFILE_EXIT_CRITICAL(interruptState);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t Profile_FormatLine(ProfilePoint point, char *line)
+{
+    // Looks like: "3: n=1200 min=14 max=96 avg=17\r\n"
+    ProfileStats s;
+    char *end = line;
+    
+    Profile_GetStats(point, &s);
+    
+    end = AppendNumber(end, point);
+    end = AppendText(end, ": n=");
+    end = AppendNumber(end, s.calls);
+    end = AppendText(end, " min=");
+    end = AppendNumber(end, s.minCycles);
+    end = AppendText(end, " max=");
+    end = AppendNumber(end, s.maxCycles);
+    end = AppendText(end, " avg=");
+    end = AppendNumber(end, s.calls ? s.totalCycles / s.calls : 0);
+    end = AppendText(end, "\r\n");
+    *end = 0;
+    
+    return (uint8_t)(end - line);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static char *AppendText(char *line, const char *text)
+{
+    while(*text)
+        *line++ = *text++;
+    
+    return line;
+}
+
+// -----------------------------------------------------------------------------
+
+static char *AppendNumber(char *line, uint32_t number)
+{
+    char digits[10];
+    uint8_t i = 0;
+    
+    // Work out the digits backwards, then copy them in the right order
+    do
+    {
+        digits[i++] = (char)('0' + number % 10);
+        number /= 10;
+    } while(number != 0);
+    
+    while(i != 0)
+        *line++ = digits[--i];
+    
+    return line;
+}
+
+/*
+ End of File
+ */
@@ -0,0 +1,130 @@
+/* *****************************************************************************
+ * @Summary Profiling Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Profile.h
+ * 
+ * @Description
+ *      Measures how long the hot paths take on the real hardware. Each
+ *      profile point remembers how many times it ran, and the shortest, 
+ *      longest, and total number of cycles it took. The libraries already 
+ *      have profile points around Buffer_WriteChar, Buffer_ReadChar, 
+ *      Timer_Tick, Button_Tick, and the UART interrupts in the example.
+ * 
+ *      None of this gets compiled unless you define PROFILE_ENABLE for your 
+ *      whole project and add this folder to your include path. You also need 
+ *      to tell it how to read a free running counter by defining 
+ *      PROFILE_GET_CYCLES(). On a Cortex-M this would be DWT->CYCCNT. On a PIC
+ *      you would let a timer run at the instruction clock and read it. If 
+ *      your counter is only 16 bits, set PROFILE_CYCLE_SIZE to 16. Recording 
+ *      a point is a subtract, two compares, and two adds, so it is cheap 
+ *      enough to leave on.
+ * 
+ *      A point can be recorded from main and from interrupts at the same 
+ *      time. The update is done with PROFILE_ENTER_CRITICAL and 
+ *      PROFILE_EXIT_CRITICAL around it, which save the interrupt state and 
+ *      turn the interrupts off with XC8. Anywhere else, define them yourself 
+ *      if you record from an interrupt.
+ * 
+ *      To dump the results, call Profile_FormatLine for each point and send 
+ *      the text out of the UART.
+ * 
+ *      Keep in mind that the time includes any interrupts that happened in 
+ *      the middle. The max will show that, but the min won't.
+ * 
+*******************************************************************************/
+
+#ifndef PROFILE_H
+#define	PROFILE_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+#ifndef PROFILE_CYCLE_SIZE
+#define PROFILE_CYCLE_SIZE  32
+#endif
+
+// Handy for testing on a PC
+#if !defined(PROFILE_GET_CYCLES) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PROFILE_GET_CYCLES()    ((ProfileCycles)__builtin_ia32_rdtsc())
+#endif
+
+#ifndef PROFILE_GET_CYCLES
+#error "Define PROFILE_GET_CYCLES() to read a free running counter"
+#endif
+
+/*  Put PROFILE_BEGIN at the top of the code you want to measure, after your
+    variables, and PROFILE_END at the bottom. Make sure you don't return in 
+    between. The start time is kept on the stack, so it is safe if the same 
+    point gets interrupted by itself. */
+#define PROFILE_BEGIN(point)    ProfileCycles profileStart_##point = PROFILE_GET_CYCLES()
+#define PROFILE_END(point)      Profile_Record(point, (ProfileCycles)(PROFILE_GET_CYCLES() - profileStart_##point))
+
+// The longest line Profile_FormatLine will make, with the null
+#define PROFILE_LINE_SIZE       64
+
+// ***** Global Variables ******************************************************
+
+#if PROFILE_CYCLE_SIZE == 16
+typedef uint16_t ProfileCycles;
+#else
+typedef uint32_t ProfileCycles;
+#endif
+
+/* If you want your own points, define PROFILE_USER_POINTS as a list of names
+ * with a comma after each one. */
+typedef enum ProfilePoint
+{
+    PROFILE_BUFFER_WRITE_CHAR,
+    PROFILE_BUFFER_READ_CHAR,
+    PROFILE_TIMER_TICK,
+    PROFILE_BUTTON_TICK,
+    PROFILE_INTERRUPT_MANAGER,
+    PROFILE_UART_RECEIVE_ISR,
+    PROFILE_UART_TRANSMIT_ISR,
+#ifdef PROFILE_USER_POINTS
+    PROFILE_USER_POINTS
+#endif
+    PROFILE_NUM_POINTS
+} ProfilePoint;
+
+typedef struct ProfileStats ProfileStats;
+
+struct ProfileStats
+{
+    uint32_t calls;
+    uint32_t totalCycles;
+    ProfileCycles minCycles;
+    ProfileCycles maxCycles;
+};
+
+/* calls        The number of times the point was recorded
+ * 
+ * totalCycles  All of the cycles added together. This will roll over 
+ *              eventually, so reset the stats every so often if you want
+ *              the average to stay good.
+ * 
+ * minCycles    The fastest time
+ * 
+ * maxCycles    The slowest time
+ * 
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void Profile_Record(ProfilePoint point, ProfileCycles cycles);
+
+void Profile_GetStats(ProfilePoint point, ProfileStats *statsOut);
+
+void Profile_Reset(void);
+
+uint8_t Profile_FormatLine(ProfilePoint point, char *line);
+
+#endif	/* PROFILE_H */
@@ -0,0 +1,428 @@
+/*******************************************************************************
+ * @Summary: Fixed Size Element Queue
+ *
+ * @author Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File Queue.c
+ *
+ * @Description
+ *      A ring buffer of fixed size items. To create a queue, the minimum you
+ *      will need is a queue object, an array, the size of one item, and the
+ *      number of items the array can hold.
+ *
+ * ****************************************************************************/
+
+#include <string.h>
+#include "Queue.h"
+
+// ***** Defines ***************************************************************
+
+/*  The head and tail move a whole item at a time. Since the array size is
+    always a multiple of the item size, they will land exactly on the end. */
+#define NextOffset(self, i)             ((i) + (self)->private.elementSize == (self)->private.arraySize ? 0 : (i) + (self)->private.elementSize)
+#define AdvanceOffset(self, i, n)       ((n) >= (self)->private.arraySize - (i) ? (n) - ((self)->private.arraySize - (i)) : (i) + (n))
+#define CountBytes(self, h, t)          ((h) >= (t) ? (h) - (t) : (self)->private.arraySize - (t) + (h))
+#define CapacityBytes(self)             ((self)->private.arraySize - (self)->private.elementSize)
+
+/*  Same rules as Buffer. The item has to be copied in before the head moves,
+    and copied out before the tail moves. */
+#ifndef QUEUE_MEMORY_BARRIER
+    #if defined(__GNUC__)
+        #define QUEUE_MEMORY_BARRIER()      __asm__ volatile ("" ::: "memory")
+    #else
+        #define QUEUE_MEMORY_BARRIER()
+    #endif
+#endif
+
+// ***** Function Prototypes ***************************************************
+
+
+// ***** Global Variables ******************************************************
+
+
+/*******************************************************************************
+ * Initializes a Queue object
+ * <p>
+ * Sets up pointers to the array. Does not allow the queue to overwrite
+ * items by default
+ *
+ * @param self  pointer to the Queue that you are going to use
+ *
+ * @param arrayIn  pointer to the array that you are going to use
+ *
+ * @param elementSize  the size of one item in bytes, like sizeof(MyType)
+ *
+ * @param numElements  the number of items the array can hold
+ *
+ * @return none
+ */
+void Queue_Init(Queue *self, void *arrayIn, QueueIndex elementSize, QueueIndex numElements)
+{
+    Queue_InitWithOverwrite(self, arrayIn, elementSize, numElements, false);
+}
+
+/*******************************************************************************
+ * This is an extension of the normal Queue_Init function.
+ * <p>
+ * Gives you a boolean that, when initialized as true, will allow the queue
+ * to throw away the oldest item once it is full. This is the same as
+ * Buffer_InitWithOverwrite.
+ *
+ * @param self  pointer to the Queue that you are going to use
+ *
+ * @param arrayIn  pointer to the array that you are going to use
+ *
+ * @param elementSize  the size of one item in bytes, like sizeof(MyType)
+ *
+ * @param numElements  the number of items the array can hold
+ *
+ * @param overwrite  enable overwrite of old items if true
+ *
+ * @return none
+ */
+void Queue_InitWithOverwrite(Queue *self, void *arrayIn, QueueIndex elementSize, QueueIndex numElements, bool overwrite)
+{
+    self->private.array = (uint8_t *)arrayIn;
+    self->private.elementSize = elementSize;
+    self->private.arraySize = elementSize * numElements;
+    self->private.head = 0;
+    self->private.tail = 0;
+    self->enableOverwrite = overwrite;
+    self->overflow = false;
+}
+
+/*******************************************************************************
+ * Copies one item into the queue. Updates the head.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @param element  pointer to the item to copy into the queue
+ *
+ * @return true if the item was stored
+ */
+bool Queue_Push(Queue *self, const void *element)
+{
+    QueueIndex head = self->private.head;
+    QueueIndex tempHead = NextOffset(self, head);
+
+    if(tempHead != self->private.tail)
+    {
+        // There is space in the queue
+        memcpy(&self->private.array[head], element, self->private.elementSize);
+        QUEUE_MEMORY_BARRIER();
+        self->private.head = tempHead;
+        return true;
+    }
+    else if(self->enableOverwrite)
+    {
+        // There is no space in the queue and overwrite is enabled
+        memcpy(&self->private.array[head], element, self->private.elementSize);
+        self->private.head = tempHead;
+        self->private.tail = NextOffset(self, self->private.tail); // Move the tail up one
+        self->overflow = true;
+        return true;
+    }
+    else
+    {
+        // There is no space in the queue and overwrite is disabled
+        self->overflow = true;
+        return false;
+    }
+}
+
+/*******************************************************************************
+ * Copies one item out of the queue. Updates the tail.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @param element  pointer to where the item should be copied to
+ *
+ * @return true if there was an item to read
+ */
+bool Queue_Pop(Queue *self, void *element)
+{
+    QueueIndex tail = self->private.tail;
+
+    if(self->private.head != tail)
+    {
+        memcpy(element, &self->private.array[tail], self->private.elementSize);
+        QUEUE_MEMORY_BARRIER();
+        self->private.tail = NextOffset(self, tail);
+        self->overflow = false;
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * Copies the oldest item out of the queue without removing it
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @param element  pointer to where the item should be copied to
+ *
+ * @return true if there was an item to read
+ */
+bool Queue_Peek(Queue *self, void *element)
+{
+    QueueIndex tail = self->private.tail;
+
+    if(self->private.head != tail)
+    {
+        memcpy(element, &self->private.array[tail], self->private.elementSize);
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * Copies a block of items into the queue. Updates the head.
+ * <p>
+ * The items are copied in at most two pieces. If there isn't enough space and
+ * overwrite is disabled, only the items that fit are stored. If overwrite is
+ * enabled, the oldest items are thrown away to make room.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @param elements  pointer to an array of items
+ *
+ * @param numElements  the number of items to store
+ *
+ * @return the number of items that were stored
+ */
+QueueIndex Queue_PushMany(Queue *self, const void *elements, QueueIndex numElements)
+{
+    const uint8_t *data = (const uint8_t *)elements;
+    QueueIndex capacity = CapacityBytes(self);
+    QueueIndex space = capacity - CountBytes(self, self->private.head, self->private.tail);
+    QueueIndex maxElements = capacity / self->private.elementSize;
+    QueueIndex length;
+    QueueIndex head = self->private.head;
+    QueueIndex firstPiece;
+
+    // Count in items until we know they fit. The bytes for more items than 
+    // the queue can ever hold might not fit in a QueueIndex.
+    if(numElements > maxElements)
+    {
+        // Only the newest items will fit
+        if(self->enableOverwrite)
+            data += (uint32_t)(numElements - maxElements) * self->private.elementSize;
+
+        numElements = maxElements;
+        self->overflow = true;
+    }
+
+    length = numElements * self->private.elementSize;
+
+    if(length > space)
+    {
+        if(self->enableOverwrite)
+        {
+            // Move the tail up to make room
+            self->private.tail = AdvanceOffset(self, self->private.tail, length - space);
+        }
+        else
+        {
+            length = space;
+            numElements = space / self->private.elementSize;
+        }
+        self->overflow = true;
+    }
+
+    firstPiece = self->private.arraySize - head;
+
+    if(firstPiece > length)
+        firstPiece = length;
+
+    memcpy(&self->private.array[head], data, firstPiece);
+    memcpy(self->private.array, data + firstPiece, length - firstPiece);
+
+    QUEUE_MEMORY_BARRIER();
+    self->private.head = AdvanceOffset(self, head, length);
+
+    return numElements;
+}
+
+/*******************************************************************************
+ * Copies a block of items out of the queue. Updates the tail.
+ * <p>
+ * If there are fewer items in the queue than you asked for, you only get what
+ * is there.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @param elements  pointer to an array to copy the items into
+ *
+ * @param numElements  the maximum number of items to read
+ *
+ * @return the number of items that were read
+ */
+QueueIndex Queue_PopMany(Queue *self, void *elements, QueueIndex numElements)
+{
+    uint8_t *data = (uint8_t *)elements;
+    QueueIndex tail = self->private.tail;
+    QueueIndex count = CountBytes(self, self->private.head, tail);
+    QueueIndex length;
+    QueueIndex firstPiece;
+
+    // Same as Queue_PushMany, don't multiply until it's small enough
+    if(numElements > count / self->private.elementSize)
+        numElements = count / self->private.elementSize;
+
+    length = numElements * self->private.elementSize;
+
+    if(length == 0)
+        return 0;
+
+    firstPiece = self->private.arraySize - tail;
+
+    if(firstPiece > length)
+        firstPiece = length;
+
+    memcpy(data, &self->private.array[tail], firstPiece);
+    memcpy(data + firstPiece, self->private.array, length - firstPiece);
+
+    QUEUE_MEMORY_BARRIER();
+    self->private.tail = AdvanceOffset(self, tail, length);
+    self->overflow = false;
+
+    return numElements;
+}
+
+/*******************************************************************************
+ * Gets the number of items stored in the queue
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @return number of items in the queue
+ */
+QueueIndex Queue_GetCount(Queue *self)
+{
+    QueueIndex head = self->private.head;
+    QueueIndex tail = self->private.tail;
+
+    return CountBytes(self, head, tail) / self->private.elementSize;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if the queue is full.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @return true if queue is full
+ */
+bool Queue_IsFull(Queue *self)
+{
+    if(NextOffset(self, self->private.head) == self->private.tail)
+        return true;
+    else
+        return false;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if there is something in the queue
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @return true if queue is not empty
+ */
+bool Queue_IsNotEmpty(Queue *self)
+{
+    if(self->private.head != self->private.tail)
+        return true;
+    else
+        return false;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if the queue overflowed
+ *
+ * The overflow flag is cleared when you call this function. It is also
+ * cleared automatically when an item is read out of the queue.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @return true if queue did overflow
+ */
+bool Queue_DidOverflow(Queue *self)
+{
+    // Automatically clear the flag
+    bool temp = self->overflow;
+    self->overflow = false;
+    return temp;
+}
+
+/*******************************************************************************
+ * Initializes a Queue that holds pointers
+ * <p>
+ * The same as Queue_Init with sizeof(void *) items, but the pointer versions 
+ * of push and pop just move the pointer instead of calling memcpy. Overwrite
+ * is always disabled. Throwing away a pointer to a pool block would lose the 
+ * block forever.
+ *
+ * @param self  pointer to the Queue that you are going to use
+ *
+ * @param arrayIn  an array of pointers
+ *
+ * @param numElements  the number of pointers the array can hold
+ *
+ * @return none
+ */
+void Queue_InitPointers(Queue *self, void **arrayIn, QueueIndex numElements)
+{
+    Queue_InitWithOverwrite(self, arrayIn, sizeof(void *), numElements, false);
+}
+
+/*******************************************************************************
+ * Puts one pointer into the queue. Updates the head.
+ * <p>
+ * Only use this with a queue made by Queue_InitPointers. Once it's in the 
+ * queue, the block belongs to whoever pops it. If the queue is full, it still
+ * belongs to you.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @param pointer  the pointer to store
+ *
+ * @return true if the pointer was stored
+ */
+bool Queue_PushPointer(Queue *self, void *pointer)
+{
+    QueueIndex head = self->private.head;
+    QueueIndex tempHead = NextOffset(self, head);
+
+    if(tempHead == self->private.tail)
+    {
+        self->overflow = true;
+        return false;
+    }
+
+    *(void **)&self->private.array[head] = pointer;
+    QUEUE_MEMORY_BARRIER();
+    self->private.head = tempHead;
+    return true;
+}
+
+/*******************************************************************************
+ * Takes one pointer out of the queue. Updates the tail.
+ *
+ * @param self  pointer to the Queue that you are using
+ *
+ * @return the oldest pointer, or zero if the queue is empty
+ */
+void *Queue_PopPointer(Queue *self)
+{
+    QueueIndex tail = self->private.tail;
+    void *pointer;
+
+    if(self->private.head == tail)
+        return 0;
+
+    pointer = *(void **)&self->private.array[tail];
+    QUEUE_MEMORY_BARRIER();
+    self->private.tail = NextOffset(self, tail);
+    self->overflow = false;
+    return pointer;
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * @Summary Fixed Size Element Queue Header
+ *
+ * @author Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File Queue.h
+ *
+ * @Description
+ *      A ring buffer for things that aren't bytes. Things like ADC samples,
+ *      CAN frames, or event records. It works just like Buffer, except that
+ *      every item is a fixed number of bytes that you set when you initialize
+ *      it. To create a queue, you will need a queue object, an array to hold
+ *      the items, the size of one item, and the number of items to hold.
+ *
+ *          CanFrame frames[16];
+ *          Queue canQueue;
+ *          Queue_Init(&canQueue, frames, sizeof(CanFrame), 16);
+ *
+ *      Items are copied in and out of the queue, either one at a time or in
+ *      blocks. The block functions copy in at most two pieces, just like
+ *      Buffer_Write and Buffer_Read.
+ *
+ *      Overflows are handled the same way as Buffer. If you initialize the
+ *      queue with overwrite enabled, the oldest item is thrown away when the
+ *      queue is full. Otherwise the new item is dropped. Either way, the
+ *      overflow flag is set until you read it or there is room again.
+ *
+ *      Like Buffer, the queue is safe to share between one writer and one
+ *      reader without disabling interrupts, as long as overwrite is disabled.
+ *      Like Buffer, one spot in the array is always left empty.
+ *
+ *      A queue can also hold pointers, like blocks from a Pool. Then only the
+ *      pointer moves through the queue and the data itself never gets copied.
+ *      Whoever pops the pointer owns the block and gives it back to the pool
+ *      when they're done.
+ *
+ *          void *frames[8];
+ *          Queue frameQueue;
+ *          Queue_InitPointers(&frameQueue, frames, 8);
+ *          ...
+ *          Queue_PushPointer(&frameQueue, block);
+ *
+ * ****************************************************************************/
+
+#ifndef QUEUE_H
+#define	QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+/*  The head and tail are kept as byte offsets into the array so that I don't
+    have to multiply on every push and pop. That means this must be big enough
+    to hold the total size of the array in bytes, not just the item count. */
+#ifndef QUEUE_INDEX_SIZE
+#define QUEUE_INDEX_SIZE    16
+#endif
+
+// ***** Global Variables ******************************************************
+
+#if QUEUE_INDEX_SIZE == 32
+typedef uint32_t QueueIndex;
+#elif QUEUE_INDEX_SIZE == 8
+typedef uint8_t QueueIndex;
+#else
+typedef uint16_t QueueIndex;
+#endif
+
+typedef struct Queue Queue;
+
+/*  Queue Object. You shouldn't really need to access anything in here
+    directly. I've provided functions to do that for you. */
+struct Queue
+{
+    volatile bool overflow;
+    bool enableOverwrite;
+
+    struct
+    {
+        uint8_t *array;
+        QueueIndex elementSize;
+        QueueIndex arraySize;
+        volatile QueueIndex head;
+        volatile QueueIndex tail;
+    } private;
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * array        A pointer to the array which holds the items
+ *
+ * elementSize  The size of one item in bytes
+ *
+ * arraySize    The total size of the array in bytes. Always a multiple of
+ *              the element size
+ *
+ * head         Byte offset of the next item to be written. Only the writer
+ *              changes this.
+ *
+ * tail         Byte offset of the next item to be read. Only the reader
+ *              changes this.
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void Queue_Init(Queue *self, void *arrayIn, QueueIndex elementSize, QueueIndex numElements);
+
+void Queue_InitWithOverwrite(Queue *self, void *arrayIn, QueueIndex elementSize, QueueIndex numElements, bool overwrite);
+
+bool Queue_Push(Queue *self, const void *element);
+
+bool Queue_Pop(Queue *self, void *element);
+
+bool Queue_Peek(Queue *self, void *element);
+
+QueueIndex Queue_PushMany(Queue *self, const void *elements, QueueIndex numElements);
+
+QueueIndex Queue_PopMany(Queue *self, void *elements, QueueIndex numElements);
+
+QueueIndex Queue_GetCount(Queue *self);
+
+bool Queue_IsFull(Queue *self);
+
+bool Queue_IsNotEmpty(Queue *self);
+
+bool Queue_DidOverflow(Queue *self);
+
+void Queue_InitPointers(Queue *self, void **arrayIn, QueueIndex numElements);
+
+bool Queue_PushPointer(Queue *self, void *pointer);
+
+void *Queue_PopPointer(Queue *self);
+
+#endif	/* QUEUE_H */
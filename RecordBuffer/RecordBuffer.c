@@ -0,0 +1,373 @@
+/* *****************************************************************************
+ * @Summary Multiple Writer Record Buffer
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File RecordBuffer.c
+ * 
+ * @Description
+ *      Every record starts with a state byte and a length byte. The state 
+ *      byte is written last, so once the reader sees it marked committed, the
+ *      rest of the record is already there. A writer only has to share the 
+ *      reserve head with the other writers. The state byte belongs to it 
+ *      until it commits, and the tail belongs to the reader.
+ * 
+ *      With atomics, the space is claimed first and the header is written 
+ *      after that, so the reader could look at the header in between. To 
+ *      make sure it never finds an old header there, the reader clears 
+ *      everything it releases. Without atomics, the header is written inside
+ *      the critical section along with the reserve head.
+ * 
+*******************************************************************************/
+
+#include <string.h>
+#include "RecordBuffer.h"
+
+// ***** Defines ***************************************************************
+
+/*  Only needed without atomics. These save whether the interrupts were on, so 
+    it's safe to use them from inside an interrupt too. */
+#ifndef RECORD_BUFFER_ENTER_CRITICAL
+    #if defined(__XC8)
+        #include <xc.h>
+        #define RECORD_BUFFER_ENTER_CRITICAL(state)     do { (state) = INTCONbits.GIE; di(); } while(0)
+        #define RECORD_BUFFER_EXIT_CRITICAL(state)      do { if(state) ei(); } while(0)
+    #else
+        #define RECORD_BUFFER_ENTER_CRITICAL(state)     ((state) = 0)
+        #define RECORD_BUFFER_EXIT_CRITICAL(state)      ((void)(state))
+    #endif
+#endif
+
+/*  The record has to be all there before the state says so, and the reader 
+    has to be done with a record before the tail lets it go. */
+#if RECORD_BUFFER_USE_ATOMICS
+    #define PublishBarrier()    atomic_thread_fence(memory_order_release)
+    #define AcquireBarrier()    atomic_thread_fence(memory_order_acquire)
+#elif defined(__GNUC__)
+    #define PublishBarrier()    __asm__ volatile ("" ::: "memory")
+    #define AcquireBarrier()    __asm__ volatile ("" ::: "memory")
+#else
+    #define PublishBarrier()
+    #define AcquireBarrier()
+#endif
+
+#define RECORD_RESERVED     0x00
+#define RECORD_COMMITTED    0xC3
+#define RECORD_PADDING      0x3C
+
+// The header plus the record, rounded up to keep every header on an even byte
+#define RecordSize(length)  ((RecordIndex)(((length) + RECORD_HEADER_SIZE + 1) & ~1))
+
+#define Wrap(self, i)       ((i) & ((self)->private.size - 1))
+
+// ***** Function Prototypes ***************************************************
+
+static void ReleaseSpace(RecordBuffer *self, RecordIndex tail, RecordIndex length);
+
+// ***** Global Variables ******************************************************
+
+
+/*******************************************************************************
+ * Initializes a RecordBuffer object
+ * <p>
+ * If the array isn't a power of two in size, only part of it is used.
+ * 
+ * @param self  pointer to the RecordBuffer that you are going to use
+ * 
+ * @param arrayIn  pointer to the array that you are going to use
+ * 
+ * @param arrayInSize  the size of said array
+ * 
+ * @return none
+ */
+void RecordBuffer_Init(RecordBuffer *self, uint8_t *arrayIn, RecordIndex arrayInSize)
+{
+    if(arrayInSize > 32768u)
+        arrayInSize = 32768u;
+    
+    // Clear the lowest bit until there is only one left
+    while(arrayInSize & (arrayInSize - 1))
+        arrayInSize &= arrayInSize - 1;
+    
+    // Nothing in here can look like a header yet
+    memset(arrayIn, RECORD_RESERVED, arrayInSize);
+    
+    self->private.buffer = arrayIn;
+    self->private.size = arrayInSize;
+    self->private.reserveHead = 0;
+    self->private.tail = 0;
+    self->overflow = false;
+}
+
+/*******************************************************************************
+ * Claims space for a record
+ * <p>
+ * Safe to call from any interrupt, at any priority, at the same time as the
+ * other writers. The space belongs to you until you call RecordBuffer_Commit.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @param length  the size of the record. 1 to 255 bytes.
+ * 
+ * @return pointer to where the record goes, or zero if there isn't room
+ */
+uint8_t *RecordBuffer_Reserve(RecordBuffer *self, uint8_t length)
+{
+    RecordIndex size = self->private.size;
+    RecordIndex need = RecordSize(length);
+    RecordIndex head;
+    RecordIndex offset;
+    RecordIndex padding;
+#if !RECORD_BUFFER_USE_ATOMICS
+    uint8_t interruptState;
+#endif
+    
+    if(length == 0 || need > size)
+        return 0;
+    
+#if RECORD_BUFFER_USE_ATOMICS
+    head = self->private.reserveHead;
+    
+    do
+    {
+        // If it won't fit before the end, skip to the start
+        offset = Wrap(self, head);
+        padding = (size - offset < need) ? size - offset : 0;
+        
+        if((RecordIndex)(head + padding + need - self->private.tail) > size)
+        {
+            self->overflow = true;
+            return 0;
+        }
+    } while(!atomic_compare_exchange_weak(&self->private.reserveHead, &head, 
+        (RecordIndex)(head + padding + need)));
+    
+    // The reader won't go past us until the state is written, and everything
+    // it released is already cleared
+    self->private.buffer[Wrap(self, head + padding) + 1] = length;
+    
+    if(padding != 0)
+    {
+        PublishBarrier();
+        self->private.buffer[offset] = RECORD_PADDING;
+    }
+#else
+    RECORD_BUFFER_ENTER_CRITICAL(interruptState);
+    head = self->private.reserveHead;
+    offset = Wrap(self, head);
+    padding = (size - offset < need) ? size - offset : 0;
+    
+    if((RecordIndex)(head + padding + need - self->private.tail) > size)
+    {
+        RECORD_BUFFER_EXIT_CRITICAL(interruptState);
+        self->overflow = true;
+        return 0;
+    }
+    
+    if(padding != 0)
+        self->private.buffer[offset] = RECORD_PADDING;
+    
+    self->private.buffer[Wrap(self, head + padding)] = RECORD_RESERVED;
+    self->private.buffer[Wrap(self, head + padding) + 1] = length;
+    PublishBarrier();
+    self->private.reserveHead = head + padding + need;
+    RECORD_BUFFER_EXIT_CRITICAL(interruptState);
+#endif
+    
+    return &self->private.buffer[Wrap(self, head + padding) + RECORD_HEADER_SIZE];
+}
+
+/*******************************************************************************
+ * Hands a record that you reserved over to the reader
+ * <p>
+ * Don't touch the record after this. It belongs to the reader now.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @param record  the pointer you got from RecordBuffer_Reserve
+ * 
+ * @return none
+ */
+void RecordBuffer_Commit(RecordBuffer *self, uint8_t *record)
+{
+    (void)self;
+    
+    // Everything we wrote has to be there before the reader can see it
+    PublishBarrier();
+    ((volatile uint8_t *)record)[-RECORD_HEADER_SIZE] = RECORD_COMMITTED;
+}
+
+/*******************************************************************************
+ * Copies a whole record in
+ * <p>
+ * The same as a reserve, a copy, and a commit.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @param data  pointer to the record
+ * 
+ * @param length  the size of the record. 1 to 255 bytes.
+ * 
+ * @return true if there was room for it
+ */
+bool RecordBuffer_Write(RecordBuffer *self, const uint8_t *data, uint8_t length)
+{
+    uint8_t *record = RecordBuffer_Reserve(self, length);
+    
+    if(record == 0)
+        return false;
+    
+    memcpy(record, data, length);
+    RecordBuffer_Commit(self, record);
+    return true;
+}
+
+/*******************************************************************************
+ * Gives you direct access to the oldest record
+ * <p>
+ * Only the reader can call this. Nothing is removed until you call 
+ * RecordBuffer_Release. If the oldest record hasn't been committed yet, you 
+ * get nothing, even if later ones are ready.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @param length  set to the size of the record
+ * 
+ * @return pointer to the record, or zero if there isn't one ready
+ */
+uint8_t *RecordBuffer_Peek(RecordBuffer *self, uint8_t *length)
+{
+    RecordIndex tail = self->private.tail;
+    RecordIndex offset;
+    uint8_t state;
+    
+    while(tail != self->private.reserveHead)
+    {
+        offset = Wrap(self, tail);
+        state = ((volatile uint8_t *)self->private.buffer)[offset];
+        AcquireBarrier();
+        
+        if(state == RECORD_PADDING)
+        {
+            // The writer skipped the end of the array
+            ReleaseSpace(self, tail, self->private.size - offset);
+            tail = self->private.tail;
+        }
+        else if(state == RECORD_COMMITTED)
+        {
+            *length = self->private.buffer[offset + 1];
+            return &self->private.buffer[offset + RECORD_HEADER_SIZE];
+        }
+        else
+        {
+            break; // Still being filled in
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Removes the record you got from RecordBuffer_Peek
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @return none
+ */
+void RecordBuffer_Release(RecordBuffer *self)
+{
+    RecordIndex tail = self->private.tail;
+    RecordIndex offset = Wrap(self, tail);
+    
+    if(tail == self->private.reserveHead || self->private.buffer[offset] != RECORD_COMMITTED)
+        return;
+    
+    ReleaseSpace(self, tail, RecordSize(self->private.buffer[offset + 1]));
+}
+
+/*******************************************************************************
+ * Copies the oldest record out and removes it
+ * <p>
+ * If the record is longer than your array, only the start of it is copied.
+ * The rest of it is thrown away.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @param data  pointer to an array to copy the record into
+ * 
+ * @param maxLength  the size of that array
+ * 
+ * @return the number of bytes copied, or zero if there wasn't a record ready
+ */
+uint8_t RecordBuffer_Read(RecordBuffer *self, uint8_t *data, uint8_t maxLength)
+{
+    uint8_t length;
+    uint8_t *record = RecordBuffer_Peek(self, &length);
+    
+    if(record == 0)
+        return 0;
+    
+    if(length > maxLength)
+        length = maxLength;
+    
+    memcpy(data, record, length);
+    RecordBuffer_Release(self);
+    return length;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if there is a record ready to read
+ * <p>
+ * Only the reader can call this.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @return true if a record is ready
+ */
+bool RecordBuffer_IsNotEmpty(RecordBuffer *self)
+{
+    uint8_t length;
+    
+    if(RecordBuffer_Peek(self, &length))
+        return true;
+    else
+        return false;
+}
+
+/*******************************************************************************
+ * A convenience function that tells you if a record didn't fit
+ * <p>
+ * The flag is cleared when you call this function.
+ * 
+ * @param self  pointer to the RecordBuffer that you are using
+ * 
+ * @return true if a record was dropped
+ */
+bool RecordBuffer_DidOverflow(RecordBuffer *self)
+{
+    // Automatically clear the flag
+    bool temp = self->overflow;
+    self->overflow = false;
+    return temp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void ReleaseSpace(RecordBuffer *self, RecordIndex tail, RecordIndex length)
+{
+#if RECORD_BUFFER_USE_ATOMICS
+    // A writer could claim this and look at it before it writes its header
+    memset(&self->private.buffer[Wrap(self, tail)], RECORD_RESERVED, length);
+#endif
+    PublishBarrier();
+    self->private.tail = tail + length;
+}
+
+/*
+ End of File
+ */
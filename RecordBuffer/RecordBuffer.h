@@ -0,0 +1,140 @@
+/* *****************************************************************************
+ * @Summary Multiple Writer Record Buffer Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File RecordBuffer.h
+ * 
+ * @Description
+ *      A ring buffer that lots of writers can add records to at the same time,
+ *      with one reader taking them out. Buffer only works with one writer. If
+ *      the UART, a timer, and the ADC all want to log something to the same 
+ *      place, they would have to turn off the interrupts around every write.
+ *      Here, each writer only holds everyone else up long enough to claim its
+ *      space. Then it fills it in whenever it wants.
+ * 
+ *      Writing a record takes two steps. RecordBuffer_Reserve claims room for
+ *      a record and gives you a pointer to it. Fill it in, then call 
+ *      RecordBuffer_Commit to let the reader have it. RecordBuffer_Write does
+ *      both for you if you already have the record somewhere else.
+ * 
+ *          uint8_t *record = RecordBuffer_Reserve(&logBuffer, 4);
+ *          if(record)
+ *          {
+ *              record[0] = ADC_LOG_ID;
+ *              ...
+ *              RecordBuffer_Commit(&logBuffer, record);
+ *          }
+ * 
+ *      The reader only ever sees records that are finished, and always in 
+ *      the order they were reserved. If an interrupt reserves a record and 
+ *      then gets interrupted by another one that writes a record of its own,
+ *      the second record waits until the first one is committed. Don't 
+ *      reserve and then hang on to a record for a long time, because nothing
+ *      after it can be read until you commit it.
+ * 
+ *      Every record is kept in one piece so that you always get a single 
+ *      pointer to it. If a record won't fit before the end of the array, the
+ *      rest of the array is skipped and the record goes at the start. Each 
+ *      record also takes two bytes for its header and is rounded up to an 
+ *      even number of bytes, so make the array a fair bit bigger than the 
+ *      records you expect to be waiting. Records can be 1 to 255 bytes.
+ * 
+ *      The array has to be a power of two in size. If it isn't, only as much
+ *      of it as makes a power of two is used. It can be up to 32768 bytes.
+ * 
+ *      If your compiler has C11 atomics, space is claimed with a compare and 
+ *      swap, and nothing ever turns the interrupts off. Otherwise, like on 
+ *      XC8, claiming space is done inside RECORD_BUFFER_ENTER_CRITICAL and 
+ *      RECORD_BUFFER_EXIT_CRITICAL, which is only a handful of instructions.
+ *      Define RECORD_BUFFER_USE_ATOMICS as 0 or 1 to choose for yourself.
+ * 
+*******************************************************************************/
+
+#ifndef RECORD_BUFFER_H
+#define	RECORD_BUFFER_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+#ifndef RECORD_BUFFER_USE_ATOMICS
+    #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+        #define RECORD_BUFFER_USE_ATOMICS   1
+    #else
+        #define RECORD_BUFFER_USE_ATOMICS   0
+    #endif
+#endif
+
+#if RECORD_BUFFER_USE_ATOMICS
+#include <stdatomic.h>
+#define RECORD_BUFFER_ATOMIC    _Atomic
+#else
+#define RECORD_BUFFER_ATOMIC    volatile
+#endif
+
+// The two bytes in front of every record
+#define RECORD_HEADER_SIZE      2
+
+// ***** Global Variables ******************************************************
+
+typedef uint16_t RecordIndex;
+
+typedef struct RecordBuffer RecordBuffer;
+
+struct RecordBuffer
+{
+    volatile bool overflow;
+    
+    struct
+    {
+        uint8_t *buffer;
+        RecordIndex size;
+        RECORD_BUFFER_ATOMIC RecordIndex reserveHead;
+        RECORD_BUFFER_ATOMIC RecordIndex tail;
+    } private;
+};
+
+/* These variable should be treated as private. You should only access them   
+ * with the use of a function.
+ * 
+ * buffer       The array that holds the records
+ * 
+ * size         The size of the array. Always a power of two.
+ * 
+ * reserveHead  Where the next record will be reserved. Every writer changes
+ *              this, but only while claiming space.
+ * 
+ * tail         Where the next record will be read from. Only the reader 
+ *              changes this.
+ * 
+ * The head and tail count up forever and roll over. They're masked with the 
+ * size to get the spot in the array.
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void RecordBuffer_Init(RecordBuffer *self, uint8_t *arrayIn, RecordIndex arrayInSize);
+
+uint8_t *RecordBuffer_Reserve(RecordBuffer *self, uint8_t length);
+
+void RecordBuffer_Commit(RecordBuffer *self, uint8_t *record);
+
+bool RecordBuffer_Write(RecordBuffer *self, const uint8_t *data, uint8_t length);
+
+uint8_t *RecordBuffer_Peek(RecordBuffer *self, uint8_t *length);
+
+void RecordBuffer_Release(RecordBuffer *self);
+
+uint8_t RecordBuffer_Read(RecordBuffer *self, uint8_t *data, uint8_t maxLength);
+
+bool RecordBuffer_IsNotEmpty(RecordBuffer *self);
+
+bool RecordBuffer_DidOverflow(RecordBuffer *self);
+
+#endif	/* RECORD_BUFFER_H */
@@ -0,0 +1,354 @@
+/* *****************************************************************************
+ * @Summary Scheduler
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Scheduler.c
+ * 
+ * @Description
+ *      Runs whichever ready task has the highest priority, one at a time. 
+ *      The ready bit is cleared before the task runs, so if more work shows 
+ *      up while it's running, the task just runs again afterwards.
+ * 
+*******************************************************************************/
+
+#include "Scheduler.h"
+
+// ***** Defines ***************************************************************
+
+/*  Setting a bit in the ready bitmap is a read-modify-write, so it can't be 
+    interrupted by something setting a different bit. These save whether the 
+    interrupts were on, so it's safe to use them from an interrupt too. */
+#ifndef SCHEDULER_ENTER_CRITICAL
+    #if defined(__XC8)
+        #include <xc.h>
+        #define SCHEDULER_ENTER_CRITICAL(state)     do { (state) = INTCONbits.GIE; di(); } while(0)
+        #define SCHEDULER_EXIT_CRITICAL(state)      do { if(state) ei(); } while(0)
+    #else
+        #define SCHEDULER_ENTER_CRITICAL(state)     ((state) = 0)
+        #define SCHEDULER_EXIT_CRITICAL(state)      ((void)(state))
+    #endif
+#endif
+
+#define TaskBit(priority)   ((SchedulerMask)1 << (priority))
+
+typedef enum SchedulerEventType SchedulerEventType;
+typedef struct SchedulerEventSource SchedulerEventSource;
+
+enum SchedulerEventType
+{
+    EVENT_TIMER,
+    EVENT_BUTTON,
+    EVENT_DATA,
+    EVENT_SPACE
+};
+
+// One Timer, Button, or Buffer that makes a task ready
+struct SchedulerEventSource
+{
+    const void *source;
+    Scheduler *scheduler;
+    uint8_t priority;
+    SchedulerEventType type;
+};
+
+// ***** Function Prototypes ***************************************************
+
+static uint8_t HighestPriority(SchedulerMask ready);
+static bool AddEventSource(Scheduler *self, uint8_t priority, const void *source, SchedulerEventType type);
+static bool ReadyFromEventSource(const void *source, SchedulerEventType type);
+static void TimerTaskEvent(Timer *timerContext);
+static void ButtonTaskEvent(Button *buttonContext, ButtonEvent event);
+static void DataTaskEvent(Buffer *bufferContext);
+static void SpaceTaskEvent(Buffer *bufferContext);
+
+// ***** Global Variables ******************************************************
+
+// The lowest bit that is set in each nibble
+static const uint8_t lowestBit[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+static SchedulerEventSource eventSources[SCHEDULER_MAX_EVENT_SOURCES];
+static uint8_t numEventSources;
+
+// ----- Initialize ------------------------------------------------------------
+
+void Scheduler_Init(Scheduler *self)
+{
+    uint8_t i;
+    
+    self->ready = 0;
+    self->idleCallbackFunc = 0;
+    
+    for(i = 0; i < SCHEDULER_MAX_TASKS; i++)
+    {
+        self->taskFuncs[i] = 0;
+        self->taskContexts[i] = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool Scheduler_AddTask(Scheduler *self, uint8_t priority, SchedulerTaskFunc Function, void *taskContext)
+{
+    // Every task needs its own priority
+    if(priority >= SCHEDULER_MAX_TASKS || self->taskFuncs[priority] != 0)
+        return false;
+    
+    self->taskContexts[priority] = taskContext;
+    self->taskFuncs[priority] = Function;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Scheduler_RemoveTask(Scheduler *self, uint8_t priority)
+{
+    uint8_t interruptState;
+    
+    if(priority >= SCHEDULER_MAX_TASKS)
+        return;
+    
+    SCHEDULER_ENTER_CRITICAL(interruptState);
+    self->ready &= ~TaskBit(priority);
+    self->taskFuncs[priority] = 0;
+    SCHEDULER_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+void Scheduler_SetReady(Scheduler *self, uint8_t priority)
+{
+    uint8_t interruptState;
+    
+    if(priority >= SCHEDULER_MAX_TASKS)
+        return;
+    
+    SCHEDULER_ENTER_CRITICAL(interruptState);
+    self->ready |= TaskBit(priority);
+    SCHEDULER_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+bool Scheduler_IsReady(Scheduler *self, uint8_t priority)
+{
+    if(priority < SCHEDULER_MAX_TASKS && (self->ready & TaskBit(priority)))
+        return true;
+    else
+        return false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Scheduler_RunNext(Scheduler *self)
+{
+    uint8_t interruptState;
+    uint8_t priority;
+    SchedulerMask ready;
+    
+    // Nothing to protect if there's nothing to do
+    if(self->ready == 0)
+        return false;
+    
+    SCHEDULER_ENTER_CRITICAL(interruptState);
+    ready = self->ready;
+    priority = HighestPriority(ready);
+    self->ready = ready & ~TaskBit(priority);
+    SCHEDULER_EXIT_CRITICAL(interruptState);
+    
+    // A task that was removed may still have been ready
+    if(self->taskFuncs[priority])
+    {
+        self->taskFuncs[priority](self->taskContexts[priority]);
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Scheduler_RunOnce(Scheduler *self)
+{
+    uint8_t interruptState;
+    
+    if(Scheduler_RunNext(self))
+        return;
+    
+    // The interrupts are off so that nothing can become ready between the 
+    // check and going to sleep. A PIC or an ARM will still wake up from an 
+    // interrupt that is enabled, and it runs as soon as we turn them back on.
+    SCHEDULER_ENTER_CRITICAL(interruptState);
+    
+    if(self->ready == 0 && self->idleCallbackFunc)
+    {
+        self->idleCallbackFunc(self);
+    }
+    SCHEDULER_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+void Scheduler_Run(Scheduler *self)
+{
+    while(1)
+    {
+        Scheduler_RunOnce(self);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void Scheduler_SetIdleCallback(Scheduler *self, SchedulerCallbackFunc Function)
+{
+    self->idleCallbackFunc = Function;
+}
+
+// ----- Event Sources ---------------------------------------------------------
+
+bool Scheduler_ReadyOnTimer(Scheduler *self, uint8_t priority, Timer *timer)
+{
+    if(!AddEventSource(self, priority, timer, EVENT_TIMER))
+        return false;
+    
+    Timer_SetFinishedCallback(timer, TimerTaskEvent);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Scheduler_ReadyOnButton(Scheduler *self, uint8_t priority, Button *button)
+{
+    if(!AddEventSource(self, priority, button, EVENT_BUTTON))
+        return false;
+    
+    Button_SetCallback(button, ButtonTaskEvent);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Scheduler_ReadyOnData(Scheduler *self, uint8_t priority, Buffer *buffer)
+{
+    if(!AddEventSource(self, priority, buffer, EVENT_DATA))
+        return false;
+    
+    Buffer_SetDataAvailableCallback(buffer, DataTaskEvent);
+    
+    // In case something is already waiting
+    if(Buffer_IsNotEmpty(buffer))
+        Scheduler_SetReady(self, priority);
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Scheduler_ReadyOnSpace(Scheduler *self, uint8_t priority, Buffer *buffer)
+{
+    if(!AddEventSource(self, priority, buffer, EVENT_SPACE))
+        return false;
+    
+    Buffer_SetSpaceAvailableCallback(buffer, SpaceTaskEvent);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t HighestPriority(SchedulerMask ready)
+{
+    uint8_t priority = 0;
+    
+    // Skip a nibble at a time, then look up the bit
+    while((ready & 0x0F) == 0)
+    {
+        ready >>= 4;
+        priority += 4;
+    }
+    return priority + lowestBit[ready & 0x0F];
+}
+
+// -----------------------------------------------------------------------------
+
+static bool AddEventSource(Scheduler *self, uint8_t priority, const void *source, SchedulerEventType type)
+{
+    uint8_t i;
+    
+    if(priority >= SCHEDULER_MAX_TASKS)
+        return false;
+    
+    // If it was already tied to a task, move it to this one
+    for(i = 0; i < numEventSources; i++)
+    {
+        if(eventSources[i].source == source && eventSources[i].type == type)
+            break;
+    }
+    
+    if(i == SCHEDULER_MAX_EVENT_SOURCES)
+        return false;
+    
+    eventSources[i].scheduler = self;
+    eventSources[i].priority = priority;
+    eventSources[i].type = type;
+    eventSources[i].source = source;
+    
+    if(i == numEventSources)
+        numEventSources++;
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool ReadyFromEventSource(const void *source, SchedulerEventType type)
+{
+    uint8_t i;
+    bool wasReady;
+    
+    for(i = 0; i < numEventSources; i++)
+    {
+        if(eventSources[i].source == source && eventSources[i].type == type)
+        {
+            // Tell them if the task still hadn't run since the last time
+            wasReady = Scheduler_IsReady(eventSources[i].scheduler, eventSources[i].priority);
+            Scheduler_SetReady(eventSources[i].scheduler, eventSources[i].priority);
+            return wasReady;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+static void TimerTaskEvent(Timer *timerContext)
+{
+    // The scheduler has the callback, so the timer can't tell that nobody saw
+    // the last one. The task only runs once for both.
+    if(ReadyFromEventSource(timerContext, EVENT_TIMER) && timerContext->missed != 0xFF)
+        timerContext->missed++;
+}
+
+static void ButtonTaskEvent(Button *buttonContext, ButtonEvent event)
+{
+    // The task can check the flags to see what happened
+    (void)event;
+    ReadyFromEventSource(buttonContext, EVENT_BUTTON);
+}
+
+static void DataTaskEvent(Buffer *bufferContext)
+{
+    ReadyFromEventSource(bufferContext, EVENT_DATA);
+}
+
+static void SpaceTaskEvent(Buffer *bufferContext)
+{
+    ReadyFromEventSource(bufferContext, EVENT_SPACE);
+}
+
+/*
+ End of File
+ */
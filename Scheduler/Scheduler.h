@@ -0,0 +1,144 @@
+/* *****************************************************************************
+ * @Summary Scheduler Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Scheduler.h
+ * 
+ * @Description
+ *      A small run-to-completion task scheduler. Instead of a main loop that 
+ *      checks every buffer, timer, and button on every pass, each piece of 
+ *      work is a task, and a task only runs after something says it has 
+ *      work to do. When nothing is ready, the idle hook is called so that 
+ *      you can go to sleep until the next interrupt.
+ * 
+ *      Every task has its own priority, from 0 to SCHEDULER_MAX_TASKS - 1. 
+ *      Zero is the highest. The ready tasks are kept as one bit each in a 
+ *      bitmap, so making a task ready is a single OR and finding the next 
+ *      one to run is a quick look at the lowest bit that's set. Tasks aren't
+ *      preempted. Each one runs until it returns, and then the highest ready
+ *      task goes next. Keep them short.
+ * 
+ *      A task is made ready with Scheduler_SetReady, which is safe to call 
+ *      from an interrupt. You can also hand the scheduler a Timer, a Button, 
+ *      or a Buffer, and it will make the task ready for you:
+ * 
+ *          Scheduler_ReadyOnTimer      when the timer finishes
+ *          Scheduler_ReadyOnButton     when the button has an event
+ *          Scheduler_ReadyOnData       when data shows up in an empty buffer
+ *          Scheduler_ReadyOnSpace      when space opens up in a full buffer
+ * 
+ *      These take over the object's callback, so the task should look at 
+ *      the object's flags itself. Whatever callback you had set is replaced,
+ *      and setting one of your own afterwards takes the object back from the
+ *      scheduler. A task that reads a buffer has to keep reading until the 
+ *      buffer is empty, because it only hears about the data that lands in 
+ *      an empty buffer. If a timer finishes again before its task gets to 
+ *      run, the task still only runs once, and Timer_GetMissedExpirations 
+ *      counts the one it didn't see.
+ * 
+ *      The ready bitmap is changed from interrupts and from the main loop, so
+ *      the main loop side is protected by SCHEDULER_ENTER_CRITICAL and 
+ *      SCHEDULER_EXIT_CRITICAL. With XC8, these turn the interrupts off and
+ *      on. Anywhere else you'll need to define them yourself.
+ * 
+*******************************************************************************/
+
+#ifndef SCHEDULER_H
+#define	SCHEDULER_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Timer.h"
+#include "Button.h"
+#include "Buffer.h"
+
+// ***** Defines ***************************************************************
+
+// Can be 8, 16, or 32 tasks
+#ifndef SCHEDULER_MAX_TASKS
+#define SCHEDULER_MAX_TASKS     8
+#endif
+
+/*  How many Timers, Buttons, and Buffers can be tied to tasks at once, for 
+    every scheduler put together. The callbacks only get the object, so this 
+    is how we find the task that it belongs to. */
+#ifndef SCHEDULER_MAX_EVENT_SOURCES
+#define SCHEDULER_MAX_EVENT_SOURCES     8
+#endif
+
+// ***** Global Variables ******************************************************
+
+#if SCHEDULER_MAX_TASKS == 32
+typedef uint32_t SchedulerMask;
+#elif SCHEDULER_MAX_TASKS == 16
+typedef uint16_t SchedulerMask;
+#else
+typedef uint8_t SchedulerMask;
+#endif
+
+typedef struct Scheduler Scheduler;
+
+/*  The context is whatever you gave Scheduler_AddTask, like the UART or the 
+    Button that the task works on */
+typedef void (*SchedulerTaskFunc)(void *taskContext);
+
+/*  callback function pointer. The context is so that you can know which 
+    scheduler is going idle. */
+typedef void (*SchedulerCallbackFunc)(Scheduler *schedulerContext);
+
+struct Scheduler
+{
+    volatile SchedulerMask ready;
+    SchedulerTaskFunc taskFuncs[SCHEDULER_MAX_TASKS];
+    void *taskContexts[SCHEDULER_MAX_TASKS];
+    SchedulerCallbackFunc idleCallbackFunc;
+};
+
+/* These variable should be treated as private. You should only access them   
+ * with the use of a function.
+ * 
+ * ready            One bit for every task that has work to do. Bit 0 is 
+ *                  priority 0.
+ * 
+ * taskFuncs        The task for each priority. Zero if there isn't one.
+ * 
+ * taskContexts     What gets passed to each task
+ * 
+ * idleCallbackFunc Called with interrupts off whenever nothing is ready
+ * 
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void Scheduler_Init(Scheduler *self);
+
+bool Scheduler_AddTask(Scheduler *self, uint8_t priority, SchedulerTaskFunc Function, void *taskContext);
+
+void Scheduler_RemoveTask(Scheduler *self, uint8_t priority);
+
+void Scheduler_SetReady(Scheduler *self, uint8_t priority);
+
+bool Scheduler_IsReady(Scheduler *self, uint8_t priority);
+
+bool Scheduler_RunNext(Scheduler *self);
+
+void Scheduler_RunOnce(Scheduler *self);
+
+void Scheduler_Run(Scheduler *self);
+
+void Scheduler_SetIdleCallback(Scheduler *self, SchedulerCallbackFunc Function);
+
+bool Scheduler_ReadyOnTimer(Scheduler *self, uint8_t priority, Timer *timer);
+
+bool Scheduler_ReadyOnButton(Scheduler *self, uint8_t priority, Button *button);
+
+bool Scheduler_ReadyOnData(Scheduler *self, uint8_t priority, Buffer *buffer);
+
+bool Scheduler_ReadyOnSpace(Scheduler *self, uint8_t priority, Buffer *buffer);
+
+#endif	/* SCHEDULER_H */
@@ -0,0 +1,73 @@
+/* *****************************************************************************
+ * @Summary Timebase
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Timebase.c
+ * 
+ * @Description
+ *      Keeps the tick count. Only the interrupt ever writes to it. On an 8-bit
+ *      micro, reading a 32-bit number takes more than one instruction, so the 
+ *      tick can happen right in the middle of reading it. Instead of turning 
+ *      off interrupts, it just gets read again until two reads match.
+ * 
+*******************************************************************************/
+
+#include "Timebase.h"
+
+// ***** Defines ***************************************************************
+
+
+// ***** Function Prototypes ***************************************************
+
+
+// ***** Global Variables ******************************************************
+
+static volatile uint32_t tickCount;
+
+// -----------------------------------------------------------------------------
+
+void Timebase_Tick(void)
+{
+    tickCount++;
+}
+
+// -----------------------------------------------------------------------------
+
+uint32_t Timebase_GetTicks(void)
+{
+    uint32_t first;
+    uint32_t second = tickCount;
+    
+    do
+    {
+        first = second;
+        second = tickCount;
+    } while(first != second);
+    
+    return second;
+}
+
+// -----------------------------------------------------------------------------
+
+uint32_t Timebase_GetTicksSince(uint32_t startTicks)
+{
+    // This still works when the count rolls over
+    return Timebase_GetTicks() - startTicks;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Timebase_HasElapsed(uint32_t startTicks, uint32_t ticks)
+{
+    if(Timebase_GetTicksSince(startTicks) >= ticks)
+        return true;
+    else
+        return false;
+}
+
+/*
+ End of File
+ */
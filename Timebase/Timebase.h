@@ -0,0 +1,71 @@
+/* *****************************************************************************
+ * @Summary Timebase Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Timebase.h
+ * 
+ * @Description
+ *      One tick counter for the whole project. Call Timebase_Tick from your 
+ *      periodic timer interrupt and everything else can ask what time it is.
+ *      The count is 32 bits, so it doesn't roll over for about 49 days with a
+ *      1 ms tick. Even when it does roll over, subtracting two tick counts 
+ *      still gives the right answer, as long as they're less than 49 days 
+ *      apart.
+ * 
+ *      Set TIMEBASE_TICK_US to how many microseconds there are in one tick. 
+ *      Then use the macros to turn times into ticks. If you give them a 
+ *      constant, the compiler does all of the math, so there are no divides 
+ *      left in your program. Divides are slow software routines on a PIC.
+ * 
+ *          Timer_Init(&ledTimer, TIMEBASE_MS_TO_TICKS(500));
+ *          Button_Init(&button, TIMEBASE_MS_TO_TICKS(20), TIMEBASE_MS_TO_TICKS(20));
+ * 
+ *      The times are rounded up to the next whole tick, so you always get at 
+ *      least as long as you asked for.
+ * 
+ *      Timebase_GetTicks has the right format for Button_SetEventTimeSource, 
+ *      so button events can be stamped with the same time as everything else.
+ * 
+*******************************************************************************/
+
+#ifndef TIMEBASE_H
+#define	TIMEBASE_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ***** Defines ***************************************************************
+
+// How long one tick is in microseconds
+#ifndef TIMEBASE_TICK_US
+#define TIMEBASE_TICK_US    1000UL
+#endif
+
+/*  These are all uint32_t. A Timer or a Button period is only 16 bits, and a 
+    CompactButton period is 8, so a long time can be cut off without any 
+    warning when it is stored. With a 1 ms tick, 16 bits is about 65 seconds.
+    Use TIMER_TICKS from Timer.h to clamp them for a Timer. */
+#define TIMEBASE_US_TO_TICKS(us)        (((uint32_t)(us) + TIMEBASE_TICK_US - 1) / TIMEBASE_TICK_US)
+
+/*  Good up to about 71 minutes. Anything longer than that should use seconds
+    so that the multiply doesn't roll over. */
+#define TIMEBASE_MS_TO_TICKS(ms)        (((uint32_t)(ms) * 1000UL + TIMEBASE_TICK_US - 1) / TIMEBASE_TICK_US)
+
+#define TIMEBASE_SECONDS_TO_TICKS(s)    ((uint32_t)(s) * TIMEBASE_MS_TO_TICKS(1000))
+
+// ***** Global Variables ******************************************************
+
+
+// ***** Function Prototypes ***************************************************
+
+void Timebase_Tick(void);
+uint32_t Timebase_GetTicks(void);
+uint32_t Timebase_GetTicksSince(uint32_t startTicks);
+bool Timebase_HasElapsed(uint32_t startTicks, uint32_t ticks);
+
+#endif	/* TIMEBASE_H */
@@ -26,10 +26,29 @@
  * pointing to the same callback function if you desire. Then you could look
  * at the Timer object to see which one called it and decide what to do.
  * 
+ * If you need something to happen over and over, make the timer periodic 
+ * instead of restarting it from the callback. A periodic timer reloads on the
+ * same tick that it finishes, so it never slips. Starting it again from the 
+ * callback only takes effect on the next tick, which costs a tick every time.
+ * If you are checking the expired flag instead of using a callback, you can 
+ * also find out how many times it finished before you got around to it.
+ * 
+ * Timer_InitMs has to divide to find the period, which is slow on a small 
+ * micro. You can also give Timer_Init the period in ticks. If you use the 
+ * macros in Timebase.h, the compiler works it out for you. For timeouts 
+ * longer than a 16-bit count can hold, define TIMER_COUNT_SIZE as 32.
+ * 
 *******************************************************************************/
 
 #include "Timer.h"
 
+#ifdef PROFILE_ENABLE
+#include "Profile.h"
+#else
+#define PROFILE_BEGIN(point)
+#define PROFILE_END(point)
+#endif
+
 // ***** Defines ***************************************************************
 
 
@@ -41,8 +60,15 @@
 
 // ----- Initialize ------------------------------------------------------------
 
+void Timer_Init(Timer *self, TimerCount periodTicks)
+{
+    self->period = periodTicks;
+}
+
 void Timer_InitMs(Timer *self, uint16_t periodMs, uint16_t tickMs)
 {
+    // This divide is done at run time. If your period is a constant, use 
+    // Timer_Init with TIMEBASE_MS_TO_TICKS instead.
     if(tickMs != 0)
         self->period = periodMs / tickMs;
 }
@@ -69,6 +95,8 @@ void Timer_Stop(Timer *self)
 
 void Timer_Tick(Timer *self)
 {
+    PROFILE_BEGIN(PROFILE_TIMER_TICK);
+    
     // Check to see if timer is active and ready to start
     if(self->flags.start && self->period != 0)
     {
@@ -84,7 +112,15 @@ void Timer_Tick(Timer *self)
         
         if(self->count == 0)
         {
-            self->flags.active = 0;
+            if(self->flags.periodic)
+                self->count = self->period; // Go again right now. No slipping.
+            else
+                self->flags.active = 0;
+            
+            // If nobody looked at the last one, it was missed
+            if(self->flags.expired && !self->timerCallbackFunc && self->missed != 0xFF)
+                self->missed++;
+            
             self->flags.expired = 1;
             
             if(self->timerCallbackFunc)
@@ -93,18 +129,19 @@ void Timer_Tick(Timer *self)
             }
         }
     }
+    PROFILE_END(PROFILE_TIMER_TICK);
 }
 
 // -----------------------------------------------------------------------------
 
-uint16_t Timer_GetCount(Timer *self)
+TimerCount Timer_GetCount(Timer *self)
 {
     return self->count;
 }
 
 // -----------------------------------------------------------------------------
 
-uint16_t Timer_GetPeriod(Timer *self)
+TimerCount Timer_GetPeriod(Timer *self)
 {
     return self->period;
 }
@@ -143,6 +180,23 @@ void Timer_SetFinishedCallback(Timer *self, TimerCallbackFunc Function)
     self->timerCallbackFunc = Function;
 }
 
+// -----------------------------------------------------------------------------
+
+void Timer_SetPeriodic(Timer *self, bool periodic)
+{
+    self->flags.periodic = periodic;
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t Timer_GetMissedExpirations(Timer *self)
+{
+    // Automatically clear the count
+    uint8_t temp = self->missed;
+    self->missed = 0;
+    return temp;
+}
+
 /*
  End of File
  */
\ No newline at end of file
@@ -21,9 +21,32 @@
 
 // ***** Defines ***************************************************************
 
+/*  The size of the period and the count. A 16-bit count only goes a little 
+    over a minute with a 1 ms tick. Make it 32 if you need long timeouts. */
+#ifndef TIMER_COUNT_SIZE
+#define TIMER_COUNT_SIZE    16
+#endif
+
+/*  The Timebase macros give you a uint32_t, which gets cut off without any 
+    warning if it doesn't fit in a 16-bit count. Wrap them in TIMER_TICKS, 
+    like TIMER_TICKS(TIMEBASE_SECONDS_TO_TICKS(90)), and anything too long 
+    gets the longest period there is instead. */
+#if TIMER_COUNT_SIZE == 32
+#define TIMER_MAX_COUNT     0xFFFFFFFFUL
+#define TIMER_TICKS(ticks)  ((TimerCount)(ticks))
+#else
+#define TIMER_MAX_COUNT     0xFFFFUL
+#define TIMER_TICKS(ticks)  ((TimerCount)((uint32_t)(ticks) > TIMER_MAX_COUNT ? TIMER_MAX_COUNT : (ticks)))
+#endif
 
 // ***** Global Variables ******************************************************
 
+#if TIMER_COUNT_SIZE == 32
+typedef uint32_t TimerCount;
+#else
+typedef uint16_t TimerCount;
+#endif
+
 typedef struct Timer Timer;
 
 /*  callback function pointer. The context is so that you can know which timer 
@@ -34,17 +57,22 @@ typedef void (*TimerCallbackFunc)(Timer *timerContext);
 // Free timer (with bit field)
 struct Timer
 {
-    uint16_t period;
-    uint16_t count;
+    TimerCount period;
+    TimerCount count;
+    uint8_t missed;
     
     TimerCallbackFunc timerCallbackFunc;
     
+    // only used by the TimerManager
+    Timer *next;
+    
     // bit field
     union {
         struct {
             unsigned start      :1;
             unsigned active     :1;
             unsigned expired    :1;
+            unsigned periodic   :1;
             unsigned            :0; // fill to nearest byte
         };
     } flags;
@@ -67,19 +95,33 @@ struct Timer
  * expired  This flag is set whenever the timer period reaches the specified 
  *          count. You must clear this flag yourself
  * 
+ * periodic When this bit is set, the timer reloads itself on the same tick 
+ *          that it finishes and keeps going
+ * 
+ * missed   The number of times the timer finished while the expired flag was
+ *          still set and there is no callback. Nobody saw those. A Scheduler
+ *          also counts the ones that finish before their task has run.
+ * 
+ * next     The next timer in the TimerManager's list. If you are using a
+ *          TimerManager, count holds the number of ticks after the previous 
+ *          timer in the list instead of the ticks left on this timer.
+ * 
  */
 
 // ***** Function Prototypes ***************************************************
 
+void Timer_Init(Timer *self, TimerCount periodTicks);
 void Timer_InitMs(Timer *self, uint16_t periodMs, uint16_t tickMs);
 void Timer_Start(Timer *self);
 void Timer_Stop(Timer *self);
 void Timer_Tick(Timer *self);
-uint16_t Timer_GetCount(Timer *self);
-uint16_t Timer_GetPeriod(Timer *self);
+TimerCount Timer_GetCount(Timer *self);
+TimerCount Timer_GetPeriod(Timer *self);
 bool Timer_IsRunning(Timer *self);
 bool Timer_IsFinished(Timer *self);
 void Timer_ClearFlag(Timer *self);
 void Timer_SetFinishedCallback(Timer *self, TimerCallbackFunc);
+void Timer_SetPeriodic(Timer *self, bool periodic);
+uint8_t Timer_GetMissedExpirations(Timer *self);
 
 #endif	/* TIMER_H */
\ No newline at end of file
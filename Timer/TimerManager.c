@@ -0,0 +1,249 @@
+/* *****************************************************************************
+ * @Summary Timer Manager
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File TimerManager.c
+ *
+ * @Description
+ *      Keeps the running timers in a list sorted by when they finish. Each
+ *      timer's count is the number of ticks between it and the timer in front
+ *      of it, so a tick only ever has to count down the first timer. When the
+ *      first timer reaches zero, it and any timers right behind it with a
+ *      count of zero are finished. Their callbacks are called the same way as
+ *      Timer_Tick would call them.
+ *
+*******************************************************************************/
+
+#include <stddef.h>
+#include "TimerManager.h"
+
+// ***** Defines ***************************************************************
+
+/*  Starting and stopping timers changes the list. If the tick happens in an
+    interrupt, it can't be allowed to run in the middle of that. These save 
+    whether the interrupts were on, so a callback that starts a timer from 
+    inside the tick doesn't turn the interrupts back on in the interrupt. */
+#ifndef TIMER_MANAGER_ENTER_CRITICAL
+    #if defined(__XC8)
+        #include <xc.h>
+        #define TIMER_MANAGER_ENTER_CRITICAL(state)     do { (state) = INTCONbits.GIE; di(); } while(0)
+        #define TIMER_MANAGER_EXIT_CRITICAL(state)      do { if(state) ei(); } while(0)
+    #else
+        #define TIMER_MANAGER_ENTER_CRITICAL(state)     ((state) = 0)
+        #define TIMER_MANAGER_EXIT_CRITICAL(state)      ((void)(state))
+    #endif
+#endif
+
+// ***** Function Prototypes ***************************************************
+
+static void InsertTimer(TimerManager *self, Timer *timer, TimerCount ticks);
+static bool RemoveTimer(TimerManager *self, Timer *timer);
+static void FinishTimers(TimerManager *self);
+
+// ***** Global Variables ******************************************************
+
+
+// ----- Initialize ------------------------------------------------------------
+
+void TimerManager_Init(TimerManager *self)
+{
+    self->first = NULL;
+}
+
+// -----------------------------------------------------------------------------
+
+void TimerManager_StartTimer(TimerManager *self, Timer *timer)
+{
+    uint8_t interruptState;
+
+    if(timer->period == 0)
+        return;
+
+    TIMER_MANAGER_ENTER_CRITICAL(interruptState);
+
+    // If it's already running, start it over
+    RemoveTimer(self, timer);
+    InsertTimer(self, timer, timer->period);
+    timer->flags.start = 0;
+    timer->flags.active = 1;
+
+    TIMER_MANAGER_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+void TimerManager_StopTimer(TimerManager *self, Timer *timer)
+{
+    uint8_t interruptState;
+
+    TIMER_MANAGER_ENTER_CRITICAL(interruptState);
+
+    RemoveTimer(self, timer);
+    timer->flags.start = 0;
+    timer->flags.active = 0;
+
+    TIMER_MANAGER_EXIT_CRITICAL(interruptState);
+}
+
+// -----------------------------------------------------------------------------
+
+void TimerManager_Tick(TimerManager *self)
+{
+    Timer *timer = self->first;
+
+    if(timer == NULL)
+        return;
+
+    timer->count--;
+
+    if(timer->count == 0)
+        FinishTimers(self);
+}
+
+// -----------------------------------------------------------------------------
+
+void TimerManager_AdvanceTicks(TimerManager *self, TimerCount ticks)
+{
+    Timer *timer = self->first;
+
+    // Go through the timers in the order they would have finished. If a
+    // callback starts a timer again, it starts from the tick it finished on,
+    // so it can finish again before we are done catching up.
+    while(timer != NULL && ticks != 0)
+    {
+        if(ticks >= timer->count)
+        {
+            ticks -= timer->count;
+            timer->count = 0;
+            FinishTimers(self);
+        }
+        else
+        {
+            timer->count -= ticks;
+            ticks = 0;
+        }
+        timer = self->first;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+TimerCount TimerManager_GetTicksUntilNextExpiry(TimerManager *self)
+{
+    // Zero means there are no timers running. You can sleep as long as you
+    // want to.
+    if(self->first == NULL)
+        return 0;
+    else
+        return self->first->count;
+}
+
+// -----------------------------------------------------------------------------
+
+TimerCount TimerManager_GetTicksRemaining(TimerManager *self, Timer *timer)
+{
+    Timer *current = self->first;
+    TimerCount ticks = 0;
+
+    while(current != NULL)
+    {
+        ticks += current->count;
+
+        if(current == timer)
+            return ticks;
+
+        current = current->next;
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void InsertTimer(TimerManager *self, Timer *timer, TimerCount ticks)
+{
+    Timer **link = &self->first;
+
+    // Find the first timer that finishes after this one. Timers that finish on
+    // the same tick stay in the order they were started.
+    while(*link != NULL && ticks >= (*link)->count)
+    {
+        ticks -= (*link)->count;
+        link = &(*link)->next;
+    }
+
+    timer->count = ticks;
+    timer->next = *link;
+
+    // The one behind us now counts from us instead
+    if(timer->next != NULL)
+        timer->next->count -= ticks;
+
+    *link = timer;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool RemoveTimer(TimerManager *self, Timer *timer)
+{
+    Timer **link = &self->first;
+
+    while(*link != NULL)
+    {
+        if(*link == timer)
+        {
+            // Give our ticks to the one behind us
+            if(timer->next != NULL)
+                timer->next->count += timer->count;
+
+            *link = timer->next;
+            timer->next = NULL;
+            return true;
+        }
+        link = &(*link)->next;
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+static void FinishTimers(TimerManager *self)
+{
+    Timer *timer = self->first;
+
+    // Finish every timer at the front of the list that is down to zero
+    while(timer != NULL && timer->count == 0)
+    {
+        self->first = timer->next;
+        timer->next = NULL;
+        
+        if(timer->flags.periodic)
+            InsertTimer(self, timer, timer->period); // Counts from this tick
+        else
+            timer->flags.active = 0;
+        
+        // If nobody looked at the last one, it was missed
+        if(timer->flags.expired && !timer->timerCallbackFunc && timer->missed != 0xFF)
+            timer->missed++;
+        
+        timer->flags.expired = 1;
+
+        if(timer->timerCallbackFunc)
+        {
+            timer->timerCallbackFunc(timer);
+        }
+
+        // The callback may have started more timers
+        timer = self->first;
+    }
+}
+
+/*
+ End of File
+ */
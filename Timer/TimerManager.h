@@ -0,0 +1,89 @@
+/* *****************************************************************************
+ * @Summary Timer Manager Header File
+ *
+ * @author  Matthew Spinks
+ *
+ * Date: Oct. 14, 2026   Original creation
+ *
+ * @File TimerManager.h
+ *
+ * @Description
+ *      Runs lots of Timer objects off of one tick. Normally, every Timer needs
+ *      its own call to Timer_Tick, even if it isn't anywhere close to
+ *      finishing. With the manager, you call TimerManager_Tick once and only
+ *      the timers that are actually finishing get touched.
+ *
+ *      The running timers are kept in a list sorted by when they finish.
+ *      Each timer only stores how many ticks it finishes after the one in
+ *      front of it. That way, a tick only has to count down the first timer
+ *      in the list. Starting a timer has to walk the list to find its spot,
+ *      but that happens far less often than a tick.
+ *
+ *      Initialize your Timers like normal with Timer_Init and set your
+ *      callbacks with Timer_SetFinishedCallback. Then use the manager's start
+ *      and stop functions instead of Timer_Start and Timer_Stop. Don't call
+ *      Timer_Tick on a timer that belongs to a manager. It is safe to start
+ *      a timer again from inside its own callback. Periodic timers are put 
+ *      back in the list on the same tick that they finish, so they don't 
+ *      drift.
+ *
+ *      The manager can also tell you how many ticks there are until the next
+ *      timer finishes. If nothing needs to happen before then, you can set up
+ *      one hardware timer for that long, go to sleep, and then catch all of
+ *      the timers up at once with TimerManager_AdvanceTicks when you wake up.
+ *      If something else wakes you up early, just advance by the number of
+ *      ticks that actually went by. A periodic timer that should have 
+ *      finished more than once while you were asleep gets its callback once 
+ *      for each time, in order. Without a callback, they are counted as 
+ *      missed.
+ *
+ *      Starting and stopping timers is protected by 
+ *      TIMER_MANAGER_ENTER_CRITICAL and TIMER_MANAGER_EXIT_CRITICAL, so you 
+ *      can call TimerManager_Tick from an interrupt. With XC8, these save 
+ *      whether the interrupts were on, turn them off, and only turn them back
+ *      on if they were on before. That keeps a callback that restarts its 
+ *      timer from inside the tick from turning the interrupts on in the 
+ *      interrupt. Anywhere else you'll need to define them yourself. They 
+ *      are given a uint8_t to save the state in.
+ *
+*******************************************************************************/
+
+#ifndef TIMER_MANAGER_H
+#define	TIMER_MANAGER_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Timer.h"
+
+// ***** Defines ***************************************************************
+
+
+// ***** Global Variables ******************************************************
+
+typedef struct TimerManager TimerManager;
+
+struct TimerManager
+{
+    Timer *first;
+};
+
+/* These variable should be treated as private. You should only access them
+ * with the use of a function.
+ *
+ * first    The running timer that will finish next
+ *
+ */
+
+// ***** Function Prototypes ***************************************************
+
+void TimerManager_Init(TimerManager *self);
+void TimerManager_StartTimer(TimerManager *self, Timer *timer);
+void TimerManager_StopTimer(TimerManager *self, Timer *timer);
+void TimerManager_Tick(TimerManager *self);
+void TimerManager_AdvanceTicks(TimerManager *self, TimerCount ticks);
+TimerCount TimerManager_GetTicksUntilNextExpiry(TimerManager *self);
+TimerCount TimerManager_GetTicksRemaining(TimerManager *self, Timer *timer);
+
+#endif	/* TIMER_MANAGER_H */
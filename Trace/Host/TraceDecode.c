@@ -0,0 +1,138 @@
+/* *****************************************************************************
+ * @Summary Trace Decoder
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File TraceDecode.c
+ * 
+ * @Description
+ *      Runs on your PC. Reads the raw trace output from the UART, finds the 
+ *      COBS frames, and prints each record with its format string and the 
+ *      time it happened. It has to be built with the same TraceFormats.h as 
+ *      your firmware.
+ * 
+ *          gcc -I.. -I../../Buffer -I../../COBS -I../../RecordBuffer
+ *              TraceDecode.c ../../COBS/COBS.c ../../Buffer/Buffer.c 
+ *              -o tracedecode
+ * 
+ *          tracedecode [microseconds per tick] < capture.bin
+ * 
+ *      The tick defaults to 1000 microseconds, the same as TIMEBASE_TICK_US.
+ * 
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Buffer.h"
+#include "COBS.h"
+#include "Trace.h"
+
+// ***** Defines ***************************************************************
+
+#define TRACE_STRING_ENTRY(id, format)  format,
+#define TRACE_NAME_ENTRY(id, format)    #id,
+
+// ***** Function Prototypes ***************************************************
+
+static void PrintRecord(const uint8_t *record, BufferIndex length, double tickUs);
+static uint32_t GetLong(const uint8_t *source);
+
+// ***** Global Variables ******************************************************
+
+static const char *formats[] =
+{
+    "*** trace records were dropped before this ***",
+    TRACE_FORMATS(TRACE_STRING_ENTRY)
+};
+
+static const char *names[] =
+{
+    "TRACE_DROPPED",
+    TRACE_FORMATS(TRACE_NAME_ENTRY)
+};
+
+// *****************************************************************************
+
+int main(int argc, char **argv)
+{
+    uint8_t array[255];
+    uint8_t frame[TRACE_MAX_RECORD];
+    Buffer input;
+    COBSDecoder decoder;
+    uint8_t *space;
+    BufferIndex length;
+    size_t received;
+    double tickUs = 1000.0;
+    
+    if(argc > 1)
+        tickUs = atof(argv[1]);
+    
+    Buffer_Init(&input, array, sizeof(array));
+    COBS_InitDecoder(&decoder, frame, sizeof(frame));
+    
+    while(1)
+    {
+        length = Buffer_ReserveContiguous(&input, &space);
+        received = fread(space, 1, length, stdin);
+        
+        if(received == 0)
+            break;
+        
+        Buffer_CommitWrite(&input, (BufferIndex)received);
+        
+        while((length = COBS_Decode(&decoder, &input)) != 0)
+            PrintRecord(frame, length, tickUs);
+        
+        if(COBS_DidDropFrame(&decoder))
+            printf("*** bad frame ***\n");
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static void PrintRecord(const uint8_t *record, BufferIndex length, double tickUs)
+{
+    uint32_t args[TRACE_MAX_ARGS] = {0, 0, 0};
+    uint8_t numArgs;
+    uint8_t i;
+    
+    if(length < TRACE_HEADER_SIZE || (length - TRACE_HEADER_SIZE) % 4 != 0 ||
+        record[0] >= TRACE_NUM_IDS)
+    {
+        printf("*** unknown record ***\n");
+        return;
+    }
+    
+    numArgs = (uint8_t)((length - TRACE_HEADER_SIZE) / 4);
+    
+    if(numArgs > TRACE_MAX_ARGS)
+        numArgs = TRACE_MAX_ARGS;
+    
+    for(i = 0; i < numArgs; i++)
+        args[i] = GetLong(&record[TRACE_HEADER_SIZE + i * 4]);
+    
+    printf("%12.3f ms  %-24s ", GetLong(&record[1]) * tickUs / 1000.0, names[record[0]]);
+    
+    // Any arguments the format doesn't use are ignored
+    printf(formats[record[0]], (unsigned)args[0], (unsigned)args[1], (unsigned)args[2]);
+    printf("\n");
+}
+
+// -----------------------------------------------------------------------------
+
+static uint32_t GetLong(const uint8_t *source)
+{
+    return (uint32_t)source[0] | ((uint32_t)source[1] << 8) |
+        ((uint32_t)source[2] << 16) | ((uint32_t)source[3] << 24);
+}
+
+/*
+ End of File
+ */
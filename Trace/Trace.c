@@ -0,0 +1,168 @@
+/* *****************************************************************************
+ * @Summary Binary Trace
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Trace.c
+ * 
+ * @Description
+ *      Every record is reserved, filled in place, and committed, so nothing 
+ *      gets copied until it goes out to the transmit buffer. The numbers are 
+ *      stored one byte at a time so that the records come out the same no 
+ *      matter what the micro is.
+ * 
+*******************************************************************************/
+
+#include "Trace.h"
+#include "COBS.h"
+
+// ***** Defines ***************************************************************
+
+#ifndef TRACE_TIMESTAMP
+#include "Timebase.h"
+#define TRACE_TIMESTAMP()   Timebase_GetTicks()
+#endif
+
+// ***** Function Prototypes ***************************************************
+
+static uint8_t *StartRecord(TraceId id, uint8_t numArgs);
+static void PutLong(uint8_t *destination, uint32_t value);
+
+// ***** Global Variables ******************************************************
+
+static RecordBuffer traceBuffer;
+
+// Set when something was dropped, until the dropped record gets sent
+static bool dropPending;
+
+// ----- Initialize ------------------------------------------------------------
+
+void Trace_Init(uint8_t *arrayIn, RecordIndex arrayInSize)
+{
+    RecordBuffer_Init(&traceBuffer, arrayIn, arrayInSize);
+    dropPending = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void Trace_Event0(TraceId id)
+{
+    uint8_t *record = StartRecord(id, 0);
+    
+    if(record)
+        RecordBuffer_Commit(&traceBuffer, record);
+}
+
+void Trace_Event1(TraceId id, uint32_t a)
+{
+    uint8_t *record = StartRecord(id, 1);
+    
+    if(record)
+    {
+        PutLong(&record[TRACE_HEADER_SIZE], a);
+        RecordBuffer_Commit(&traceBuffer, record);
+    }
+}
+
+void Trace_Event2(TraceId id, uint32_t a, uint32_t b)
+{
+    uint8_t *record = StartRecord(id, 2);
+    
+    if(record)
+    {
+        PutLong(&record[TRACE_HEADER_SIZE], a);
+        PutLong(&record[TRACE_HEADER_SIZE + 4], b);
+        RecordBuffer_Commit(&traceBuffer, record);
+    }
+}
+
+void Trace_Event3(TraceId id, uint32_t a, uint32_t b, uint32_t c)
+{
+    uint8_t *record = StartRecord(id, 3);
+    
+    if(record)
+    {
+        PutLong(&record[TRACE_HEADER_SIZE], a);
+        PutLong(&record[TRACE_HEADER_SIZE + 4], b);
+        PutLong(&record[TRACE_HEADER_SIZE + 8], c);
+        RecordBuffer_Commit(&traceBuffer, record);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t Trace_Flush(Buffer *out)
+{
+    uint8_t dropped[TRACE_HEADER_SIZE];
+    uint8_t encoded[COBS_MAX_ENCODED_SIZE(TRACE_MAX_RECORD)];
+    BufferIndex encodedLength;
+    uint8_t *record;
+    uint8_t length;
+    uint16_t sent = 0;
+    
+    if(RecordBuffer_DidOverflow(&traceBuffer))
+        dropPending = true;
+    
+    // Send as many as will fit in one piece. The rest wait for next time.
+    while((record = RecordBuffer_Peek(&traceBuffer, &length)) != 0)
+    {
+        // The records are short and full of zeros, so encode them in one go
+        encodedLength = COBS_Encode(encoded, record, length);
+        
+        if(Buffer_GetSpace(out) < encodedLength)
+            return sent;
+        
+        Buffer_Write(out, encoded, encodedLength);
+        RecordBuffer_Release(&traceBuffer);
+        sent++;
+    }
+    
+    // Once we've caught up, say that some went missing before this
+    if(dropPending)
+    {
+        dropped[0] = TRACE_DROPPED;
+        PutLong(&dropped[1], TRACE_TIMESTAMP());
+        
+        if(COBS_EncodeFrame(out, dropped, TRACE_HEADER_SIZE))
+        {
+            dropPending = false;
+            sent++;
+        }
+    }
+    return sent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// ***** Local Functions *****************************************************//
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t *StartRecord(TraceId id, uint8_t numArgs)
+{
+    uint8_t *record = RecordBuffer_Reserve(&traceBuffer, TRACE_HEADER_SIZE + numArgs * 4);
+    
+    // If it's full, the reader will notice the overflow
+    if(record)
+    {
+        record[0] = (uint8_t)id;
+        PutLong(&record[1], TRACE_TIMESTAMP());
+    }
+    return record;
+}
+
+// -----------------------------------------------------------------------------
+
+static void PutLong(uint8_t *destination, uint32_t value)
+{
+    destination[0] = (uint8_t)value;
+    destination[1] = (uint8_t)(value >> 8);
+    destination[2] = (uint8_t)(value >> 16);
+    destination[3] = (uint8_t)(value >> 24);
+}
+
+/*
+ End of File
+ */
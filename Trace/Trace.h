@@ -0,0 +1,106 @@
+/* *****************************************************************************
+ * @Summary Binary Trace Header File
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File Trace.h
+ * 
+ * @Description
+ *      Debug messages without the printf. Formatting a string takes way more
+ *      time than most of the code you would want to trace, so instead, only 
+ *      the raw numbers are sent. Each message is a tiny binary record with an
+ *      id for the format string, a timestamp, and up to three arguments. The
+ *      format strings live in TraceFormats.h and only the host decoder ever 
+ *      uses them. Tracing a message is just a handful of byte stores, so you 
+ *      can leave it on in the field.
+ * 
+ *          TRACE2(TRACE_BUTTON_EVENT, buttonId, event);
+ * 
+ *      The TRACE macros only do anything when TRACE_ENABLE is defined, so you
+ *      can take them all out at once without touching your code.
+ * 
+ *      The records go into a RecordBuffer, so it's safe to trace from any 
+ *      interrupt at the same time as the main loop. Call Trace_Flush from 
+ *      your main loop, or from a Scheduler task, to move them into your UART
+ *      transmit buffer. Each one is sent as a COBS frame so that the decoder 
+ *      can find the start of a record even if it starts listening halfway 
+ *      through.
+ * 
+ *          if(Trace_Flush(&txBuffer) != 0)
+ *              UART_TransmitStart(&uart1);
+ * 
+ *      If the trace buffer fills up, new records are dropped instead of 
+ *      holding anything up. A TRACE_DROPPED record is sent afterwards so you 
+ *      can tell from the output.
+ * 
+ *      The timestamp is Timebase_GetTicks. To use something else, define 
+ *      TRACE_TIMESTAMP as a function or macro that gives back a uint32_t.
+ * 
+ *      Records look like this, with everything in little endian:
+ * 
+ *          id (1 byte) | timestamp (4 bytes) | arguments (4 bytes each)
+ * 
+ *      Build Host/TraceDecode.c with the same TraceFormats.h to read them.
+ * 
+*******************************************************************************/
+
+#ifndef TRACE_H
+#define	TRACE_H
+
+// ***** Includes **************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Buffer.h"
+#include "RecordBuffer.h"
+#include "TraceFormats.h"
+
+// ***** Defines ***************************************************************
+
+#define TRACE_HEADER_SIZE   5
+#define TRACE_MAX_ARGS      3
+#define TRACE_MAX_RECORD    (TRACE_HEADER_SIZE + TRACE_MAX_ARGS * 4)
+
+#ifdef TRACE_ENABLE
+    #define TRACE0(id)              Trace_Event0(id)
+    #define TRACE1(id, a)           Trace_Event1(id, (uint32_t)(a))
+    #define TRACE2(id, a, b)        Trace_Event2(id, (uint32_t)(a), (uint32_t)(b))
+    #define TRACE3(id, a, b, c)     Trace_Event3(id, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+#else
+    #define TRACE0(id)
+    #define TRACE1(id, a)
+    #define TRACE2(id, a, b)
+    #define TRACE3(id, a, b, c)
+#endif
+
+#define TRACE_ENUM_ENTRY(id, format)    id,
+
+// ***** Global Variables ******************************************************
+
+typedef enum TraceId TraceId;
+
+// Zero is saved for the dropped record
+enum TraceId
+{
+    TRACE_DROPPED,
+    TRACE_FORMATS(TRACE_ENUM_ENTRY)
+    TRACE_NUM_IDS
+};
+
+// ***** Function Prototypes ***************************************************
+
+void Trace_Init(uint8_t *arrayIn, RecordIndex arrayInSize);
+
+void Trace_Event0(TraceId id);
+
+void Trace_Event1(TraceId id, uint32_t a);
+
+void Trace_Event2(TraceId id, uint32_t a, uint32_t b);
+
+void Trace_Event3(TraceId id, uint32_t a, uint32_t b, uint32_t c);
+
+uint16_t Trace_Flush(Buffer *out);
+
+#endif	/* TRACE_H */
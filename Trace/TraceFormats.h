@@ -0,0 +1,34 @@
+/* *****************************************************************************
+ * @Summary Trace Formats
+ * 
+ * @author  Matthew Spinks
+ * 
+ * Date: Oct. 14, 2026   Original creation
+ * 
+ * @File TraceFormats.h
+ * 
+ * @Description
+ *      Every trace message your project can send, one per line. The first 
+ *      part is the name you use in your code. The second is the format 
+ *      string, which never goes in your program. Only the host decoder sees 
+ *      it, so make them as long and as helpful as you like. Use %u, %d, or %x
+ *      for the arguments. Each one is 32 bits.
+ * 
+ *      Make your own copy of this file for your project. The decoder has to 
+ *      be built with the same copy as your firmware or the messages will not
+ *      line up. Only ever add new ones to the end.
+ * 
+*******************************************************************************/
+
+#ifndef TRACE_FORMATS_H
+#define	TRACE_FORMATS_H
+
+#define TRACE_FORMATS(FORMAT) \
+    FORMAT(TRACE_STARTUP,           "Started up") \
+    FORMAT(TRACE_UART_OVERRUN,      "UART overrun, status 0x%02x") \
+    FORMAT(TRACE_BUFFER_OVERFLOW,   "Buffer overflow, %u bytes waiting") \
+    FORMAT(TRACE_BUTTON_EVENT,      "Button %u event %u") \
+    FORMAT(TRACE_TIMER_MISSED,      "Timer %u missed %u times") \
+    FORMAT(TRACE_ADC_SAMPLE,        "ADC channel %u = %u (limit %u)")
+
+#endif	/* TRACE_FORMATS_H */